@@ -4,6 +4,8 @@ import { stringify } from './utils'
 import {
   ZlibCompressionLevel,
   ZlibFlush,
+  ZlibMemoryProfile,
+  ZlibPriority,
   ZlibStrategy,
   type Zlib,
   type ZlibOptions,
@@ -64,6 +66,17 @@ function generateTestData(size: number = 1000): string {
   return 'Hello, this is test data! '.repeat(size)
 }
 
+function concatChunks(chunks: ArrayBuffer[]): ArrayBuffer {
+  const totalLength = chunks.reduce((acc, chunk) => acc + chunk.byteLength, 0)
+  const result = new Uint8Array(totalLength)
+  let offset = 0
+  chunks.forEach((chunk) => {
+    result.set(new Uint8Array(chunk), offset)
+    offset += chunk.byteLength
+  })
+  return result.buffer
+}
+
 async function testStream(
   stream: ZlibStream,
   input: ArrayBuffer
@@ -73,19 +86,7 @@ async function testStream(
 
     stream.onData((chunk) => chunks.push(chunk))
     stream.onError(reject)
-    stream.onEnd(() => {
-      const totalLength = chunks.reduce(
-        (acc, chunk) => acc + chunk.byteLength,
-        0
-      )
-      const result = new Uint8Array(totalLength)
-      let offset = 0
-      chunks.forEach((chunk) => {
-        result.set(new Uint8Array(chunk), offset)
-        offset += chunk.byteLength
-      })
-      resolve(result.buffer)
-    })
+    stream.onEnd(() => resolve(concatChunks(chunks)))
 
     stream.write(input)
     stream.end()
@@ -158,6 +159,96 @@ export function getTests(zlib: Zlib): TestRunner[] {
       )
     ),
 
+    // Experimental parallel gunzip
+    createTest('gunzipParallel matches gunzip', async () => {
+      const original = generateTestData(200000)
+      const originalBuffer = stringToArrayBuffer(original)
+
+      return it(async () => {
+        const compressed = await zlib.gzip(originalBuffer)
+        const decompressed = await zlib.gunzipParallel(compressed)
+        return arrayBufferToString(decompressed) === original
+      })
+    }),
+
+    createTest('gzipSyncWithInfo reports sizes and checksum', async () => {
+      const original = generateTestData(10000)
+      const originalBuffer = stringToArrayBuffer(original)
+
+      return it(async () => {
+        const compressed = zlib.gzipSyncWithInfo(originalBuffer)
+        const decompressed = await zlib.gunzipWithInfo(compressed.buffer)
+        return (
+          compressed.info.bytesIn === originalBuffer.byteLength &&
+          compressed.info.bytesOut === compressed.buffer.byteLength &&
+          compressed.info.checksum === decompressed.info.checksum &&
+          decompressed.info.gzipHeader !== undefined &&
+          arrayBufferToString(decompressed.buffer) === original
+        )
+      })
+    }),
+
+    createTest('adaptive deflate stores incompressible data', async () => {
+      const random = new Uint8Array(64 * 1024)
+      for (let i = 0; i < random.length; i++) {
+        random[i] = Math.floor(Math.random() * 256)
+      }
+
+      return it(() => {
+        const result = zlib.deflateSyncWithInfo(random.buffer, { adaptive: true })
+        const decompressed = new Uint8Array(zlib.inflateSync(result.buffer))
+        return (
+          result.info.adaptive?.level === 0 &&
+          decompressed.length === random.length &&
+          decompressed.every((b, i) => b === random[i])
+        )
+      })
+    }),
+
+    createTest('tune returns a frontier and usable options', async () => {
+      const samples = [
+        stringToArrayBuffer(generateTestData(20000)),
+        stringToArrayBuffer(generateTestData(5000)),
+      ]
+
+      return it(async () => {
+        const result = await zlib.tune(samples, { ratioWeight: 1 })
+        const compressed = zlib.deflateSync(samples[0]!, result.recommended)
+        return (
+          result.frontier.length > 0 &&
+          result.evaluated >= result.frontier.length &&
+          result.recommended.level === result.best.level &&
+          arrayBufferToString(zlib.inflateSync(compressed)) ===
+            arrayBufferToString(samples[0]!)
+        )
+      })
+    }),
+
+    createTest('metrics record calls and bytes', async () => {
+      const original = generateTestData(10000)
+      const originalBuffer = stringToArrayBuffer(original)
+
+      return it(() => {
+        zlib.resetMetrics()
+        zlib.setMetricsEnabled(true)
+        const compressed = zlib.gzipSync(originalBuffer)
+        zlib.gunzipSync(compressed)
+        zlib.gunzipSync(compressed)
+        const metrics = zlib.getMetrics()
+        zlib.setMetricsEnabled(false)
+
+        const gzip = metrics.find((m) => m.operation === 'gzipSync')
+        const gunzip = metrics.find((m) => m.operation === 'gunzipSync')
+        return (
+          gzip?.calls === 1 &&
+          gzip.bytesIn === originalBuffer.byteLength &&
+          gzip.bytesOut === compressed.byteLength &&
+          gunzip?.calls === 2 &&
+          gunzip.p50Ms >= 0
+        )
+      })
+    }),
+
     // Stream tests
     createTest('deflate stream basic functionality', async () => {
       const original = generateTestData()
@@ -274,6 +365,32 @@ export function getTests(zlib: Zlib): TestRunner[] {
       })
     }),
 
+    createTest('unzip detects gzip, zlib and raw deflate', async () => {
+      const original = generateTestData()
+      const originalBuffer = stringToArrayBuffer(original)
+
+      return it(async () => {
+        const encoded = [
+          zlib.gzipSync(originalBuffer),
+          zlib.deflateSync(originalBuffer),
+          zlib.deflateRawSync(originalBuffer),
+        ]
+        for (const data of encoded) {
+          if (arrayBufferToString(zlib.unzipSync(data)) !== original) return false
+          if (arrayBufferToString(await zlib.unzip(data)) !== original) return false
+          const unzipStream = zlib.createUnzipStream()
+          const chunks: ArrayBuffer[] = []
+          unzipStream.onData((chunk) => chunks.push(chunk))
+          // A one byte first chunk is not enough to tell the formats apart
+          unzipStream.write(data.slice(0, 1))
+          unzipStream.write(data.slice(1))
+          unzipStream.end()
+          if (arrayBufferToString(concatChunks(chunks)) !== original) return false
+        }
+        return true
+      })
+    }),
+
     createTest(
       'deflateRaw/inflateRaw stream pair works correctly',
       async () => {
@@ -292,6 +409,423 @@ export function getTests(zlib: Zlib): TestRunner[] {
       }
     ),
 
+    createTest('stream factories reject invalid windowBits', async () => {
+      const options: ZlibOptions = { windowBits: 20 }
+
+      return it(() => {
+        const factories = [
+          () => zlib.createInflateStream(options),
+          () => zlib.createUnzipStream(options),
+        ]
+        return factories.every((create) => {
+          try {
+            create()
+            return false
+          } catch (error) {
+            return error instanceof Error
+          }
+        })
+      })
+    }),
+
+    createTest('low-memory gzip stream keeps gzip framing', async () => {
+      const original = generateTestData(5000)
+      const originalBuffer = stringToArrayBuffer(original)
+      const options: ZlibOptions = { windowBits: 9, memLevel: 1, chunkSize: 1024 }
+
+      return it(async () => {
+        const compressed = await testStream(
+          zlib.createGzipStream(options),
+          originalBuffer
+        )
+        const viaStream = await testStream(
+          zlib.createGunzipStream(options),
+          compressed
+        )
+        return (
+          arrayBufferToString(zlib.gunzipSync(compressed)) === original &&
+          arrayBufferToString(viaStream) === original
+        )
+      })
+    }),
+
+    createTest('low-memory raw stream survives going idle', async () => {
+      const message = generateTestData(200)
+      const messageBuffer = stringToArrayBuffer(message)
+
+      return it(() => {
+        const stream = zlib.createDeflateRawStream({
+          memoryProfile: ZlibMemoryProfile.LOW,
+        })
+        const chunks: ArrayBuffer[] = []
+        stream.onData((chunk) => chunks.push(chunk))
+        // Each full flush releases the zlib state, the next write re-creates it
+        stream.write(messageBuffer)
+        stream.flush(ZlibFlush.FULL_FLUSH)
+        stream.write(messageBuffer)
+        stream.flush(ZlibFlush.FULL_FLUSH)
+        stream.end()
+        const decompressed = zlib.inflateRawSync(concatChunks(chunks))
+        return arrayBufferToString(decompressed) === message + message
+      })
+    }),
+
+    createTest('low-memory raw stream applies its dictionary only at the start', async () => {
+      const items = Array.from({ length: 300 }, (_, i) => `item ${i}, `).join('')
+      const dictionary = stringToArrayBuffer('item 0, item 1, item 2, item 3, ')
+
+      return it(() => {
+        const stream = zlib.createDeflateRawStream({
+          memoryProfile: ZlibMemoryProfile.LOW,
+          dictionary,
+        })
+        const chunks: ArrayBuffer[] = []
+        stream.onData((chunk) => chunks.push(chunk))
+        // The second message comes from a re-created deflater, the peer's window holds the first one
+        stream.write(stringToArrayBuffer(items))
+        stream.flush(ZlibFlush.FULL_FLUSH)
+        stream.write(stringToArrayBuffer(items))
+        stream.end()
+        const decompressed = zlib.inflateRawSync(concatChunks(chunks), {
+          dictionary,
+        })
+        return arrayBufferToString(decompressed) === items + items
+      })
+    }),
+
+    createTest('low-memory inflate stream releases its state at the end', async () => {
+      const original = generateTestData(2000)
+      const compressed = zlib.deflateSync(stringToArrayBuffer(original))
+
+      return it(() => {
+        const stream = zlib.createInflateStream({
+          memoryProfile: ZlibMemoryProfile.LOW,
+        })
+        const chunks: ArrayBuffer[] = []
+        let ended = false
+        let failed = false
+        stream.onData((chunk) => chunks.push(chunk))
+        stream.onEnd(() => (ended = true))
+        stream.onError(() => (failed = true))
+        stream.write(compressed)
+        const idleSize = stream.getMemorySize()
+        stream.end()
+        return (
+          idleSize === 0 &&
+          ended &&
+          !failed &&
+          arrayBufferToString(concatChunks(chunks)) === original
+        )
+      })
+    }),
+
+    createTest('permessage-deflate negotiates and round-trips messages', async () => {
+      const message = generateTestData(200)
+      const messageBuffer = stringToArrayBuffer(message)
+
+      return it(() => {
+        const client = zlib.createPerMessageDeflate({
+          isServer: false,
+          clientNoContextTakeover: true,
+        })
+        const server = zlib.createPerMessageDeflate({ isServer: true })
+        const response = server.negotiate(client.offer())
+        client.negotiate(response)
+        // Second message reuses the server's window, so it must come out smaller
+        const first = server.compress(messageBuffer)
+        const second = server.compress(messageBuffer)
+        const up = client.compress(messageBuffer)
+        return (
+          response.includes('client_no_context_takeover') &&
+          second.byteLength < first.byteLength &&
+          arrayBufferToString(client.decompress(first)) === message &&
+          arrayBufferToString(client.decompress(second)) === message &&
+          arrayBufferToString(server.decompress(up)) === message
+        )
+      })
+    }),
+
+    createTest('content decoder reads split multi-member gzip', async () => {
+      const part = generateTestData(300)
+      const first = new Uint8Array(zlib.gzipSync(stringToArrayBuffer(part)))
+      const second = new Uint8Array(zlib.gzipSync(stringToArrayBuffer(part)))
+      const body = new Uint8Array(first.length + second.length)
+      body.set(first)
+      body.set(second, first.length)
+
+      return it(() => {
+        const ring = new ArrayBuffer(256)
+        const decoder = zlib.createContentDecoder('gzip', ring)
+        const out: number[] = []
+        const read = () => {
+          const bytes = new Uint8Array(ring)
+          while (decoder.readable > 0) {
+            out.push(bytes[decoder.readOffset]!)
+            decoder.consume(1)
+          }
+        }
+        // 3 byte slices split the gzip headers and the member boundary
+        for (let i = 0; i < body.length; i += 3) {
+          decoder.write(body.slice(i, i + 3).buffer)
+          read()
+        }
+        decoder.end()
+        const decoded = arrayBufferToString(new Uint8Array(out).buffer)
+        return decoder.finished && decoded === part + part
+      })
+    }),
+
+    createTest('gunzipInto writes into an arena at an offset', async () => {
+      const original = generateTestData(100)
+      const compressed = zlib.gzipSync(stringToArrayBuffer(original))
+      const size = stringToArrayBuffer(original).byteLength
+
+      return it(() => {
+        const arena = new ArrayBuffer(size + 16)
+        const written = zlib.gunzipInto(compressed, arena, 16)
+        const decoded = arrayBufferToString(arena.slice(16, 16 + written))
+        let overflowed = false
+        try {
+          zlib.gunzipInto(compressed, arena, 17)
+        } catch (e) {
+          overflowed = String(e).includes(`${size} bytes needed`)
+        }
+        const rejects = (fn: () => void, message: string) => {
+          try {
+            fn()
+            return false
+          } catch (e) {
+            return String(e).includes(message)
+          }
+        }
+        // Compressed bytes copied into the arena, then decoded over themselves
+        const shared = new ArrayBuffer(compressed.byteLength + size)
+        new Uint8Array(shared).set(new Uint8Array(compressed))
+        const overlapping = rejects(
+          () =>
+            zlib.gunzipInto(shared, shared, 8, {
+              byteLength: compressed.byteLength,
+            }),
+          'overlaps'
+        )
+        const separate =
+          zlib.gunzipInto(shared, shared, compressed.byteLength, {
+            byteLength: compressed.byteLength,
+          }) === size
+        return (
+          written === size &&
+          decoded === original &&
+          overflowed &&
+          rejects(() => zlib.gunzipInto(compressed, arena, NaN), 'dstOffset') &&
+          rejects(() => zlib.gunzipInto(compressed, arena, 1.5), 'dstOffset') &&
+          overlapping &&
+          separate
+        )
+      })
+    }),
+
+    createTest('string APIs round-trip UTF-8 text', async () => {
+      const original = generateTestData(100) + ' héllo wörld ✓ 日本語'
+
+      return it(() => {
+        const gzipped = zlib.gzipString(original)
+        const deflated = zlib.deflateString(original)
+        return (
+          zlib.gunzipToString(gzipped) === original &&
+          zlib.inflateToString(deflated) === original &&
+          arrayBufferToString(zlib.gunzipSync(gzipped)) === original
+        )
+      })
+    }),
+
+    createTest('base64 APIs round-trip through JSON-safe text', async () => {
+      const original = generateTestData(100)
+      const input = stringToArrayBuffer(original)
+
+      return it(() => {
+        const text = zlib.gzipToBase64(input)
+        // Same bytes as gzipSync, and line breaks in the input are skipped
+        const binary = new Uint8Array(zlib.gzipSync(input))
+        const expected = btoa(String.fromCharCode(...binary))
+        const wrapped = text.replace(/.{76}/g, '$&\n')
+        return (
+          text === expected &&
+          arrayBufferToString(zlib.gunzipFromBase64(wrapped)) === original &&
+          arrayBufferToString(zlib.inflateFromBase64(zlib.deflateToBase64(input))) === original
+        )
+      })
+    }),
+
+    createTest('CompressedBuffer handles chain without an ArrayBuffer', async () => {
+      const original = generateTestData(500)
+
+      return it(() => {
+        const handle = zlib.gzipToHandle(stringToArrayBuffer(original))
+        const copy = new Uint8Array(handle.toArrayBuffer())
+        copy[0] = 0
+        const restored = zlib.gunzipToHandle(handle)
+        const unzipped = zlib.unzipToHandle(handle)
+        return (
+          handle.byteLength < original.length &&
+          restored.byteLength === original.length &&
+          arrayBufferToString(restored.toArrayBuffer()) === original &&
+          arrayBufferToString(unzipped.toArrayBuffer()) === original
+        )
+      })
+    }),
+
+    createTest('interactive gunzip completes while background gzip runs', async () => {
+      const bulk = stringToArrayBuffer(generateTestData(100000))
+      const original = generateTestData(100)
+      const compressed = zlib.gzipSync(stringToArrayBuffer(original))
+
+      return it(async () => {
+        const background = [1, 2, 3].map(() =>
+          zlib.gzip(bulk, { priority: ZlibPriority.BACKGROUND })
+        )
+        const interactive = await zlib.gunzip(compressed, {
+          priority: ZlibPriority.INTERACTIVE,
+        })
+        const bulkResults = await Promise.all(background)
+        return (
+          arrayBufferToString(interactive) === original &&
+          bulkResults.every((result) => zlib.gunzipSync(result).byteLength === bulk.byteLength)
+        )
+      })
+    }),
+
+    createTest('segmented gunzip splits output into fixed-size buffers', async () => {
+      const original = generateTestData(10000)
+      const compressed = zlib.gzipSync(stringToArrayBuffer(original))
+
+      return it(async () => {
+        const segments = await zlib.gunzipSegmented(compressed, 1024)
+        return (
+          segments
+            .slice(0, -1)
+            .every((segment) => segment.byteLength === 1024) &&
+          arrayBufferToString(concatChunks(segments)) === original
+        )
+      })
+    }),
+
+    createTest('gunzip progress ends at the totals', async () => {
+      const original = stringToArrayBuffer(generateTestData(200000))
+      const compressed = zlib.gzipSync(original)
+
+      return it(async () => {
+        const reports: [number, number][] = []
+        const result = await zlib.gunzip(compressed, {
+          onProgress: (bytesIn, bytesOut) => reports.push([bytesIn, bytesOut]),
+          progressIntervalMs: 0,
+        })
+        // Reports are queued on the JS thread, let them run
+        await new Promise((resolve) => setTimeout(resolve, 0))
+        const last = reports[reports.length - 1]
+        return (
+          reports.length > 1 &&
+          reports.every((report, i) => i === 0 || report[0] >= reports[i - 1]![0]) &&
+          last![0] === compressed.byteLength &&
+          last![1] === result.byteLength
+        )
+      })
+    }),
+
+    createTest('abort token rejects a running gunzip', async () => {
+      const original = generateTestData(200000)
+      const compressed = zlib.gzipSync(stringToArrayBuffer(original))
+
+      return it(async () => {
+        const token = zlib.createAbortToken()
+        const pending = zlib.gunzip(compressed, { signal: token })
+        token.abort()
+        const aborted = await pending.then(
+          () => false,
+          (error: Error) => error.message.includes('aborted')
+        )
+        let expired = false
+        try {
+          zlib.gunzipSync(compressed, { deadlineMs: 0 })
+        } catch (error) {
+          expired = (error as Error).message.includes('Deadline')
+        }
+        const untouched = await zlib.gunzip(compressed, { signal: zlib.createAbortToken() })
+        return aborted && expired && arrayBufferToString(untouched) === original
+      })
+    }),
+
+    createTest('aborted job is rejected before zlib starts', async () => {
+      const compressed = zlib.gzipSync(stringToArrayBuffer(generateTestData(1000)))
+
+      return it(async () => {
+        const token = zlib.createAbortToken()
+        token.abort()
+        // windowBits 20 would fail inflateInit2, the abort has to win
+        return zlib.gunzip(compressed, { signal: token, windowBits: 20 }).then(
+          () => false,
+          (error: Error) => error.message.includes('aborted')
+        )
+      })
+    }),
+
+    createTest('compressed store evicts least recently used entries', async () => {
+      const documents = [0, 1, 2].map((i) => generateTestData(2000) + i)
+
+      return it(async () => {
+        const store = zlib.createCompressedStore({ maxHotBytes: 0 })
+        await Promise.all(documents.map((doc, i) => store.put(`doc${i}`, stringToArrayBuffer(doc))))
+        const roundTrip = documents.every(
+          (doc, i) => arrayBufferToString(store.get(`doc${i}`)!) === doc
+        )
+        const compressed = store.originalBytes > store.compressedBytes * 10
+
+        // Room for about two entries: reading doc0 makes doc1 the oldest
+        const small = zlib.createCompressedStore({
+          maxCompressedBytes: Math.ceil((store.compressedBytes * 2) / 3) + 8,
+        })
+        await small.put('doc0', stringToArrayBuffer(documents[0]!))
+        await small.put('doc1', stringToArrayBuffer(documents[1]!))
+        small.get('doc0')
+        await small.put('doc2', stringToArrayBuffer(documents[2]!))
+
+        return (
+          roundTrip &&
+          compressed &&
+          small.has('doc0') &&
+          !small.has('doc1') &&
+          small.has('doc2') &&
+          small.evictions === 1 &&
+          small.get('doc1') === undefined
+        )
+      })
+    }),
+
+    createTest('byteOffset/byteLength read a payload inside a frame', async () => {
+      const original = generateTestData(100)
+      const payload = new Uint8Array(zlib.gzipSync(stringToArrayBuffer(original)))
+      // 8 byte header, payload, 4 byte trailer
+      const frame = new Uint8Array(8 + payload.length + 4)
+      frame.set(payload, 8)
+
+      return it(() => {
+        const range = { byteOffset: 8, byteLength: payload.length }
+        const oneShot = zlib.gunzipSync(frame.buffer, range)
+
+        const stream = zlib.createGunzipStream()
+        const chunks: ArrayBuffer[] = []
+        stream.onData((chunk) => chunks.push(chunk))
+        const half = Math.floor(payload.length / 2)
+        stream.write(frame.buffer, 8, half)
+        stream.write(frame.buffer, 8 + half, payload.length - half)
+        stream.end()
+
+        return (
+          arrayBufferToString(oneShot) === original &&
+          arrayBufferToString(concatChunks(chunks)) === original
+        )
+      })
+    }),
+
     createTest('stream with different chunk sizes', async () => {
       const original = generateTestData(10000) // Larger test data
       const originalBuffer = stringToArrayBuffer(original)
@@ -365,6 +899,24 @@ export function getTests(zlib: Zlib): TestRunner[] {
       })
     ),
 
+    createTest('one-shot flush option still applies', async () => {
+      const original = generateTestData()
+
+      return it(async () => {
+        // Without FINISH the output ends at a sync flush marker instead of a trailer
+        const flushed = new Uint8Array(
+          zlib.deflateSync(stringToArrayBuffer(original), {
+            flush: ZlibFlush.SYNC_FLUSH,
+          })
+        )
+        const tail = Array.from(flushed.slice(-4)).join(',')
+        const restored = zlib.inflateSync(flushed.buffer, {
+          finishFlush: ZlibFlush.SYNC_FLUSH,
+        })
+        return tail === '0,0,255,255' && arrayBufferToString(restored) === original
+      })
+    }),
+
     // Test stream error handling
     createTest('stream handles write after end', async () => {
       const stream = zlib.createDeflateStream()
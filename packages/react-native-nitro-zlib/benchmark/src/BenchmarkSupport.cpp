@@ -0,0 +1,181 @@
+#include "BenchmarkSupport.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <random>
+
+#if defined(__GLIBC__) && RNZLIB_BENCH_COUNT_ALLOCATIONS
+namespace
+{
+    std::atomic<uint64_t> gAllocations{0};
+    std::atomic<uint64_t> gAllocatedBytes{0};
+
+    inline void countAllocation(size_t size)
+    {
+        gAllocations.fetch_add(1, std::memory_order_relaxed);
+        gAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+} // namespace
+
+// Interpose the C allocator so allocations made inside libz and operator new are counted too
+extern "C"
+{
+    void *__libc_malloc(size_t size);
+    void *__libc_calloc(size_t count, size_t size);
+    void *__libc_realloc(void *ptr, size_t size);
+    void __libc_free(void *ptr);
+
+    void *malloc(size_t size)
+    {
+        countAllocation(size);
+        return __libc_malloc(size);
+    }
+
+    void *calloc(size_t count, size_t size)
+    {
+        countAllocation(count * size);
+        return __libc_calloc(count, size);
+    }
+
+    void *realloc(void *ptr, size_t size)
+    {
+        countAllocation(size);
+        return __libc_realloc(ptr, size);
+    }
+
+    void free(void *ptr)
+    {
+        __libc_free(ptr);
+    }
+}
+#define RNZLIB_ALLOCATION_TRACKING 1
+#else
+#define RNZLIB_ALLOCATION_TRACKING 0
+#endif
+
+namespace margelo::nitro::rnzlib::bench
+{
+
+    bool allocationTrackingEnabled()
+    {
+        return RNZLIB_ALLOCATION_TRACKING;
+    }
+
+    AllocationStats allocationStats()
+    {
+#if RNZLIB_ALLOCATION_TRACKING
+        return {gAllocations.load(std::memory_order_relaxed), gAllocatedBytes.load(std::memory_order_relaxed)};
+#else
+        return {};
+#endif
+    }
+
+    void resetPeakRss()
+    {
+        // Writing 5 to clear_refs resets VmHWM to the current RSS
+        std::ofstream clearRefs("/proc/self/clear_refs");
+        if (clearRefs)
+            clearRefs << "5";
+    }
+
+    size_t peakRssBytes()
+    {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line))
+        {
+            if (line.rfind("VmHWM:", 0) == 0)
+                return static_cast<size_t>(std::strtoull(line.c_str() + 6, nullptr, 10)) * 1024;
+        }
+        return 0;
+    }
+
+    const std::vector<uint8_t> &textPayload(size_t size)
+    {
+        static std::mutex mutex;
+        static std::map<size_t, std::vector<uint8_t>> cache;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto &payload = cache[size];
+        if (payload.size() == size)
+            return payload;
+
+        static const char *const keys[] = {"id", "timestamp", "level", "message", "user", "duration", "status"};
+        static const char *const words[] = {"request", "completed", "cache", "miss", "retry", "timeout",
+                                            "session", "upload", "sync", "error", "ok", "queued"};
+        std::mt19937 rng(1234);
+        std::string text;
+        text.reserve(size + 256);
+        while (text.size() < size)
+        {
+            text += "{\"";
+            text += keys[rng() % 7];
+            text += "\":";
+            text += std::to_string(rng() % 100000);
+            text += ",\"";
+            text += keys[rng() % 7];
+            text += "\":\"";
+            text += words[rng() % 12];
+            text += ' ';
+            text += words[rng() % 12];
+            text += "\"}\n";
+        }
+        payload.assign(text.begin(), text.begin() + static_cast<std::ptrdiff_t>(size));
+        return payload;
+    }
+
+    std::shared_ptr<ArrayBuffer> makeBuffer(const uint8_t *data, size_t size)
+    {
+        uint8_t *bytes = new uint8_t[size == 0 ? 1 : size];
+        if (size > 0)
+            std::memcpy(bytes, data, size);
+        return std::make_shared<NativeArrayBuffer>(bytes, size, [bytes]()
+                                                   { delete[] bytes; });
+    }
+
+    std::shared_ptr<ArrayBuffer> makeBuffer(const std::vector<uint8_t> &bytes)
+    {
+        return makeBuffer(bytes.data(), bytes.size());
+    }
+
+    bool equals(const std::shared_ptr<ArrayBuffer> &buffer, const std::vector<uint8_t> &bytes)
+    {
+        return buffer && buffer->size() == bytes.size() &&
+               (bytes.empty() || std::memcmp(buffer->data(), bytes.data(), bytes.size()) == 0);
+    }
+
+    ZlibOptions emptyOptions()
+    {
+        return ZlibOptions();
+    }
+
+    std::vector<size_t> payloadSizes()
+    {
+        size_t maxBytes = 16 * 1024 * 1024;
+        if (const char *env = std::getenv("RNZLIB_BENCH_MAX_BYTES"))
+            maxBytes = static_cast<size_t>(std::strtoull(env, nullptr, 10));
+
+        std::vector<size_t> sizes;
+        for (size_t size : {size_t(100), size_t(10) << 10, size_t(1) << 20, size_t(16) << 20,
+                            size_t(128) << 20, size_t(500) << 20})
+        {
+            if (size <= maxBytes)
+                sizes.push_back(size);
+        }
+        return sizes;
+    }
+
+    std::string formatSize(size_t bytes)
+    {
+        if (bytes >= (1 << 20) && bytes % (1 << 20) == 0)
+            return std::to_string(bytes >> 20) + "M";
+        if (bytes >= 1024 && bytes % 1024 == 0)
+            return std::to_string(bytes >> 10) + "K";
+        return std::to_string(bytes);
+    }
+
+} // namespace margelo::nitro::rnzlib::bench
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include "ZlibOptions.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::rnzlib::bench
+{
+
+    // Process-wide allocation counters (malloc/calloc/realloc), zero if not supported
+    struct AllocationStats
+    {
+        uint64_t count = 0;
+        uint64_t bytes = 0;
+    };
+
+    bool allocationTrackingEnabled();
+    AllocationStats allocationStats();
+
+    // Peak resident set size since the last resetPeakRss(), in bytes (Linux only)
+    void resetPeakRss();
+    size_t peakRssBytes();
+
+    // Deterministic text-like payload (JSON-ish records), cached per size
+    const std::vector<uint8_t> &textPayload(size_t size);
+
+    std::shared_ptr<ArrayBuffer> makeBuffer(const std::vector<uint8_t> &bytes);
+    std::shared_ptr<ArrayBuffer> makeBuffer(const uint8_t *data, size_t size);
+    bool equals(const std::shared_ptr<ArrayBuffer> &buffer, const std::vector<uint8_t> &bytes);
+
+    // ZlibOptions with every field unset
+    ZlibOptions emptyOptions();
+
+    // Payload sizes to run, capped by RNZLIB_BENCH_MAX_BYTES (default 16 MiB)
+    std::vector<size_t> payloadSizes();
+    std::string formatSize(size_t bytes);
+
+} // namespace margelo::nitro::rnzlib::bench
@@ -0,0 +1,196 @@
+#include "Corpus.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+
+namespace margelo::nitro::rnzlib::bench
+{
+
+    namespace
+    {
+        // std::mt19937 is specified bit-exactly, unlike the std distributions,
+        // so only raw draws are used to keep the corpus identical everywhere
+        class Random
+        {
+        public:
+            explicit Random(uint32_t seed) : _engine(seed) {}
+
+            uint32_t next() { return static_cast<uint32_t>(_engine()); }
+            uint32_t below(uint32_t bound) { return next() % bound; }
+
+            template <typename T, size_t N>
+            const T &pick(const T (&values)[N]) { return values[below(static_cast<uint32_t>(N))]; }
+
+        private:
+            std::mt19937 _engine;
+        };
+
+        void putVarint(std::vector<uint8_t> &out, uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                out.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        std::vector<uint8_t> truncate(const std::string &text, size_t size)
+        {
+            return std::vector<uint8_t>(text.begin(), text.begin() + static_cast<std::ptrdiff_t>(std::min(size, text.size())));
+        }
+
+        const char *const kEvents[] = {"app_open", "screen_view", "button_tap", "purchase", "sync_complete",
+                                       "upload_failed", "push_received", "session_end"};
+        const char *const kScreens[] = {"Home", "Settings", "Profile", "Feed", "Checkout", "Search"};
+        const char *const kPlatforms[] = {"ios", "android"};
+        const char *const kLevels[] = {"DEBUG", "INFO", "INFO", "INFO", "WARN", "ERROR"};
+        const char *const kComponents[] = {"net.http", "db.sqlite", "ui.render", "auth", "sync.worker", "cache"};
+        const char *const kMessages[] = {"request completed", "cache miss for key", "retrying after timeout",
+                                         "connection reset by peer", "flushed pending writes", "token refreshed",
+                                         "dropped frame budget exceeded", "scheduled background task"};
+    } // namespace
+
+    std::vector<uint8_t> generateJsonTelemetry(size_t size, uint32_t seed)
+    {
+        Random random(seed);
+        std::string text;
+        text.reserve(size + 512);
+        uint64_t timestamp = 1700000000000ULL;
+        char line[512];
+        while (text.size() < size)
+        {
+            timestamp += random.below(5000);
+            int n = std::snprintf(line, sizeof(line),
+                                  "{\"event\":\"%s\",\"ts\":%llu,\"session\":\"%08x-%04x\",\"screen\":\"%s\","
+                                  "\"platform\":\"%s\",\"duration_ms\":%u,\"props\":{\"count\":%u,\"ok\":%s}}\n",
+                                  random.pick(kEvents), static_cast<unsigned long long>(timestamp),
+                                  random.below(16) * 0x11111111u, random.below(0x10000), random.pick(kScreens),
+                                  random.pick(kPlatforms), random.below(2000), random.below(100),
+                                  random.below(10) == 0 ? "false" : "true");
+            text.append(line, static_cast<size_t>(n));
+        }
+        return truncate(text, size);
+    }
+
+    std::vector<uint8_t> generateTextLogs(size_t size, uint32_t seed)
+    {
+        Random random(seed);
+        std::string text;
+        text.reserve(size + 512);
+        unsigned seconds = 0;
+        char line[512];
+        while (text.size() < size)
+        {
+            seconds += random.below(3);
+            int n = std::snprintf(line, sizeof(line), "2024-03-%02u %02u:%02u:%02u.%03u %-5s [%s] %s id=%u latency=%ums\n",
+                                  1 + (seconds / 86400) % 28, (seconds / 3600) % 24, (seconds / 60) % 60, seconds % 60,
+                                  random.below(1000), random.pick(kLevels), random.pick(kComponents),
+                                  random.pick(kMessages), random.below(100000), random.below(900));
+            text.append(line, static_cast<size_t>(n));
+        }
+        return truncate(text, size);
+    }
+
+    std::vector<uint8_t> generateProtobufLike(size_t size, uint32_t seed)
+    {
+        Random random(seed);
+        std::vector<uint8_t> out;
+        out.reserve(size + 64);
+
+        uint64_t id = 1;
+        while (out.size() < size)
+        {
+            // field 1: varint id, field 2: fixed64 timestamp, field 3: string, field 4: packed varints
+            id += 1 + random.below(4);
+            putVarint(out, (1 << 3) | 0);
+            putVarint(out, id);
+
+            putVarint(out, (2 << 3) | 1);
+            uint64_t timestamp = 1700000000000ULL + id * 1000 + random.below(1000);
+            for (int i = 0; i < 8; i++)
+                out.push_back(static_cast<uint8_t>(timestamp >> (8 * i)));
+
+            const char *name = random.pick(kScreens);
+            putVarint(out, (3 << 3) | 2);
+            putVarint(out, std::char_traits<char>::length(name));
+            out.insert(out.end(), name, name + std::char_traits<char>::length(name));
+
+            std::vector<uint8_t> packed;
+            unsigned count = 1 + random.below(8);
+            for (unsigned i = 0; i < count; i++)
+                putVarint(packed, random.below(1u << (7 * (1 + random.below(3)))));
+            putVarint(out, (4 << 3) | 2);
+            putVarint(out, packed.size());
+            out.insert(out.end(), packed.begin(), packed.end());
+        }
+        out.resize(size);
+        return out;
+    }
+
+    std::vector<uint8_t> generateImage(size_t size, uint32_t seed)
+    {
+        Random random(seed);
+        std::vector<uint8_t> out(size);
+        const size_t width = 1024;
+        for (size_t i = 0; i + 3 < size; i += 4)
+        {
+            size_t pixel = i / 4;
+            size_t x = pixel % width;
+            size_t y = pixel / width;
+            uint8_t noise = static_cast<uint8_t>(random.below(5));
+
+            if ((x / 128 + y / 128) % 3 == 0)
+            {
+                // Flat UI-like area
+                out[i] = 240;
+                out[i + 1] = 240;
+                out[i + 2] = 245;
+            }
+            else
+            {
+                // Photo-like gradient with sensor noise
+                out[i] = static_cast<uint8_t>((x * 255 / width + noise) & 0xff);
+                out[i + 1] = static_cast<uint8_t>((y * 3 + noise) & 0xff);
+                out[i + 2] = static_cast<uint8_t>(((x + y) / 4 + noise) & 0xff);
+            }
+            out[i + 3] = 255;
+        }
+        return out;
+    }
+
+    std::vector<uint8_t> generateRandom(size_t size, uint32_t seed)
+    {
+        Random random(seed);
+        std::vector<uint8_t> out(size);
+        for (size_t i = 0; i < size; i++)
+            out[i] = static_cast<uint8_t>(random.next() >> 24);
+        return out;
+    }
+
+    std::vector<CorpusEntry> standardCorpus(size_t size)
+    {
+        std::vector<CorpusEntry> corpus;
+        corpus.push_back({"json-telemetry", generateJsonTelemetry(size, 1)});
+        corpus.push_back({"text-logs", generateTextLogs(size, 2)});
+        corpus.push_back({"protobuf-like", generateProtobufLike(size, 3)});
+        corpus.push_back({"image-rgba", generateImage(size, 4)});
+        corpus.push_back({"random", generateRandom(size, 5)});
+        return corpus;
+    }
+
+    void writeCorpus(const std::vector<CorpusEntry> &corpus, const std::string &directory)
+    {
+        for (const auto &entry : corpus)
+        {
+            std::string path = directory + "/" + entry.name + ".bin";
+            std::ofstream file(path, std::ios::binary);
+            if (!file)
+                throw std::runtime_error("Cannot write " + path);
+            file.write(reinterpret_cast<const char *>(entry.data.data()), static_cast<std::streamsize>(entry.data.size()));
+        }
+    }
+
+} // namespace margelo::nitro::rnzlib::bench
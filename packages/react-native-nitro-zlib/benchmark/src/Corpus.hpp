@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::rnzlib::bench
+{
+
+    /**
+     * Reproducible compression corpus. Every entry is generated from a fixed
+     * seed, so the same size always yields byte-identical data on every machine
+     * and results can be compared across runs and commits.
+     */
+    struct CorpusEntry
+    {
+        std::string name;
+        std::vector<uint8_t> data;
+    };
+
+    // JSON telemetry events, one object per line
+    std::vector<uint8_t> generateJsonTelemetry(size_t size, uint32_t seed);
+    // Plain-text application log lines
+    std::vector<uint8_t> generateTextLogs(size_t size, uint32_t seed);
+    // Protobuf-like records: tags, varints, fixed64 and short strings
+    std::vector<uint8_t> generateProtobufLike(size_t size, uint32_t seed);
+    // Uncompressed RGBA image (gradients, flat areas and sensor noise)
+    std::vector<uint8_t> generateImage(size_t size, uint32_t seed);
+    // Uniformly random bytes (incompressible)
+    std::vector<uint8_t> generateRandom(size_t size, uint32_t seed);
+
+    // All corpus kinds, each `size` bytes long
+    std::vector<CorpusEntry> standardCorpus(size_t size);
+
+    // Writes every entry to `directory`/<name>.bin so other tools can use the same inputs
+    void writeCorpus(const std::vector<CorpusEntry> &corpus, const std::string &directory);
+
+} // namespace margelo::nitro::rnzlib::bench
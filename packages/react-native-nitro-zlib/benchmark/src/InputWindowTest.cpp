@@ -0,0 +1,111 @@
+#include "ZlibCodec.hpp"
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace margelo::nitro::rnzlib;
+
+/**
+ * Built against a core compiled with a tiny RNZLIB_INPUT_WINDOW, so every
+ * one-shot call feeds zlib in many windows the way >4 GB inputs do on device.
+ * Exits with 1 when any check fails.
+ *
+ *   zlib_input_window_test
+ */
+
+static_assert(RNZLIB_INPUT_WINDOW < 4096, "build this test with a small RNZLIB_INPUT_WINDOW");
+
+namespace
+{
+    int failures = 0;
+
+    void check(bool condition, const std::string &message)
+    {
+        if (!condition)
+        {
+            std::fprintf(stderr, "FAIL: %s\n", message.c_str());
+            failures++;
+        }
+    }
+
+    // Half repetitive text, half seeded noise, so deflate emits a mix of block types
+    std::vector<uint8_t> makePayload(size_t size)
+    {
+        static const char text[] = "Hello, this is test data! ";
+        std::mt19937 rng(0x5eed);
+        std::vector<uint8_t> payload(size);
+        for (size_t i = 0; i < size; i++)
+            payload[i] = (i / 4096) % 2 == 0 ? static_cast<uint8_t>(text[i % (sizeof(text) - 1)]) : static_cast<uint8_t>(rng());
+        return payload;
+    }
+
+    bool equals(const std::shared_ptr<ArrayBuffer> &buffer, const uint8_t *data, size_t size)
+    {
+        return buffer->size() == size && std::memcmp(buffer->data(), data, size) == 0;
+    }
+
+    std::string errorOf(const std::function<void()> &fn)
+    {
+        try
+        {
+            fn();
+        }
+        catch (const std::exception &e)
+        {
+            return e.what();
+        }
+        return "";
+    }
+
+    template <Format F>
+    void roundTrip(const char *name, const std::vector<uint8_t> &payload, const CodecParams &params)
+    {
+        const auto compressed = runCodec<Direction::Deflate, F>(payload.data(), payload.size(), params);
+        CodecSummary summary;
+        const auto restored = runCodec<Direction::Inflate, F>(compressed->data(), compressed->size(), params, &summary);
+        check(equals(restored, payload.data(), payload.size()), std::string(name) + ": round trip differs");
+        check(summary.bytesIn == compressed->size(), std::string(name) + ": bytesIn doesn't cover every window");
+        check(summary.bytesOut == payload.size(), std::string(name) + ": bytesOut differs");
+
+        const std::string error = errorOf([&]()
+                                          { runCodec<Direction::Inflate, F>(compressed->data(), compressed->size() / 2, params); });
+        check(error == "Unexpected end of input", std::string(name) + ": truncated input threw \"" + error + "\"");
+    }
+} // namespace
+
+int main()
+{
+    const auto payload = makePayload(200 * 1024);
+    const CodecParams params;
+
+    roundTrip<Format::Gzip>("gzip", payload, params);
+    roundTrip<Format::Zlib>("zlib", payload, params);
+    roundTrip<Format::Raw>("raw", payload, params);
+
+    // Feeding in windows must not change what deflate emits
+    std::vector<uint8_t> reference(compressBound(payload.size()));
+    uLongf referenceLength = reference.size();
+    int ret = compress2(reference.data(), &referenceLength, payload.data(), payload.size(), Z_DEFAULT_COMPRESSION);
+    check(ret == Z_OK, "compress2 failed");
+    const auto zlibOutput = runCodec<Direction::Deflate, Format::Zlib>(payload.data(), payload.size(), params);
+    check(equals(zlibOutput, reference.data(), referenceLength), "zlib output differs from compress2");
+
+    // A partial flush only applies once the last window is in
+    CodecParams sync;
+    sync.finishFlush = Z_SYNC_FLUSH;
+    const auto flushed = runCodec<Direction::Deflate, Format::Raw>(payload.data(), payload.size(), sync);
+    static const uint8_t syncMarker[] = {0x00, 0x00, 0xff, 0xff};
+    check(flushed->size() > 4 && std::memcmp(flushed->data() + flushed->size() - 4, syncMarker, 4) == 0,
+          "sync flush: output doesn't end with a sync marker");
+    const auto unflushed = runCodec<Direction::Inflate, Format::Raw>(flushed->data(), flushed->size(), sync);
+    check(equals(unflushed, payload.data(), payload.size()), "sync flush: round trip differs");
+
+    if (failures > 0)
+        return 1;
+    std::printf("input window %u: all checks passed\n", static_cast<unsigned>(RNZLIB_INPUT_WINDOW));
+    return 0;
+}
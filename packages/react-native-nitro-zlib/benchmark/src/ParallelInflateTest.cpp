@@ -0,0 +1,79 @@
+#include "ParallelInflate.hpp"
+#include "WorkerPool.hpp"
+#include "ZlibCodec.hpp"
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace margelo::nitro::rnzlib;
+
+/**
+ * Gunzips a payload large enough for ParallelInflate to actually split it
+ * across workers and checks the result byte-for-byte against serial inflate.
+ * Also decodes from inside a background pool job, whose single thread must
+ * run the chunks itself. Exits with 1 when the parallel path bails out or
+ * disagrees.
+ *
+ *   zlib_parallel_inflate_test
+ */
+
+namespace
+{
+    // Seeded text over a small alphabet: deflate still emits dynamic Huffman
+    // blocks (which the boundary search needs) but barely shrinks it, so the
+    // compressed body spans several of the decoder's 1 MB chunks
+    std::vector<uint8_t> makePayload(size_t size)
+    {
+        static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789.,\n";
+        std::mt19937 rng(0x5eed);
+        std::uniform_int_distribution<size_t> pick(0, sizeof(alphabet) - 2);
+        std::vector<uint8_t> payload(size);
+        for (auto &byte : payload)
+            byte = static_cast<uint8_t>(alphabet[pick(rng)]);
+        return payload;
+    }
+
+    bool check(bool condition, const char *message)
+    {
+        if (!condition)
+            std::fprintf(stderr, "FAIL: %s\n", message);
+        return condition;
+    }
+} // namespace
+
+int main()
+{
+    const auto payload = makePayload(8 << 20);
+    const CodecParams params;
+    const auto compressed = runCodec<Direction::Deflate, Format::Gzip>(payload.data(), payload.size(), params);
+    std::printf("payload %zu bytes, gzip %zu bytes\n", payload.size(), compressed->size());
+
+    ParallelInflate::Config config;
+    config.maxThreads = 4;
+    if (!check(compressed->size() >= 2 * config.minChunkSize, "compressed payload too small to split"))
+        return 1;
+
+    const auto serial = runCodec<Direction::Inflate, Format::Gzip>(compressed->data(), compressed->size(), params);
+    const auto parallel = ParallelInflate::gunzip(compressed->data(), compressed->size(), config);
+
+    bool ok = check(parallel.has_value(), "parallel decoder fell back");
+    ok = ok && check(!parallel->empty(), "parallel output is empty");
+    ok = ok && check(parallel->size() == serial->size(), "parallel and serial sizes differ");
+    ok = ok && check(std::memcmp(parallel->data(), serial->data(), serial->size()) == 0, "parallel and serial bytes differ");
+    ok = ok && check(serial->size() == payload.size() && std::memcmp(serial->data(), payload.data(), payload.size()) == 0,
+                     "serial output doesn't match the payload");
+
+    // The one background worker can't pick up chunk jobs while it runs this one
+    config.priority = JobPriority::Background;
+    const auto pooled = WorkerPool::shared().submit([&]()
+                                                    { return ParallelInflate::gunzip(compressed->data(), compressed->size(), config); },
+                                                    JobPriority::Background)
+                            .get();
+    ok = ok && check(pooled.has_value() && *pooled == *parallel, "parallel gunzip inside a background job differs");
+    if (!ok)
+        return 1;
+
+    std::printf("parallel gunzip ok\n");
+    return 0;
+}
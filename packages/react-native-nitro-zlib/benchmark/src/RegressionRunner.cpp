@@ -0,0 +1,218 @@
+#include "BenchmarkSupport.hpp"
+#include "Corpus.hpp"
+#include "HybridZlib.hpp"
+#include "Report.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace margelo::nitro;
+using namespace margelo::nitro::rnzlib;
+using namespace margelo::nitro::rnzlib::bench;
+
+/**
+ * Runs a fixed set of operations over the standard corpus, writes a JSON and
+ * markdown report, and optionally compares throughput against a stored
+ * baseline report. Exits with 1 when a tracked operation regressed.
+ *
+ *   zlib_regression [--corpus-bytes=N] [--min-time=SECONDS] [--json=PATH]
+ *                   [--markdown=PATH] [--baseline=PATH] [--threshold=0.10]
+ *                   [--write-corpus=DIR]
+ */
+
+namespace
+{
+    using SyncFn = std::shared_ptr<ArrayBuffer> (HybridZlib::*)(const std::shared_ptr<ArrayBuffer> &, const std::optional<ZlibOptions> &);
+    using StreamFn = std::shared_ptr<HybridZlibStreamSpec> (HybridZlib::*)(const std::optional<ZlibOptions> &);
+
+    // Throughput of these is gated against the baseline
+    const std::vector<std::string> kTrackedOperations = {"gzipSync", "gunzipSync", "deflateStream", "inflateStream"};
+
+    constexpr size_t kStreamChunkSize = 64 * 1024;
+
+    struct Options
+    {
+        size_t corpusBytes = 1 << 20;
+        double minTime = 0.25;
+        double threshold = 0.10;
+        std::string jsonPath;
+        std::string markdownPath;
+        std::string baselinePath;
+        std::string corpusDirectory;
+    };
+
+    Options parseOptions(int argc, char **argv)
+    {
+        Options options;
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            auto value = [&arg](const char *name) -> const char *
+            {
+                size_t length = std::char_traits<char>::length(name);
+                return arg.compare(0, length, name) == 0 ? arg.c_str() + length : nullptr;
+            };
+
+            if (const char *v = value("--corpus-bytes="))
+                options.corpusBytes = static_cast<size_t>(std::strtoull(v, nullptr, 10));
+            else if (const char *v = value("--min-time="))
+                options.minTime = std::strtod(v, nullptr);
+            else if (const char *v = value("--threshold="))
+                options.threshold = std::strtod(v, nullptr);
+            else if (const char *v = value("--json="))
+                options.jsonPath = v;
+            else if (const char *v = value("--markdown="))
+                options.markdownPath = v;
+            else if (const char *v = value("--baseline="))
+                options.baselinePath = v;
+            else if (const char *v = value("--write-corpus="))
+                options.corpusDirectory = v;
+            else
+                throw std::runtime_error("Unknown argument: " + arg);
+        }
+        return options;
+    }
+
+    HybridZlib &zlib()
+    {
+        static auto instance = std::make_shared<HybridZlib>();
+        return *instance;
+    }
+
+    // Calls `operation` until `minTime` has passed (at least 5, at most 10000 times)
+    std::vector<double> measure(const std::function<void()> &operation, double minTime)
+    {
+        using Clock = std::chrono::steady_clock;
+        std::vector<double> latenciesUs;
+        auto start = Clock::now();
+        while (latenciesUs.size() < 10000)
+        {
+            auto before = Clock::now();
+            operation();
+            auto after = Clock::now();
+            latenciesUs.push_back(std::chrono::duration<double, std::micro>(after - before).count());
+
+            if (latenciesUs.size() >= 5 && std::chrono::duration<double>(after - start).count() >= minTime)
+                break;
+        }
+        return latenciesUs;
+    }
+
+    std::shared_ptr<ArrayBuffer> runStream(StreamFn create, const std::vector<uint8_t> &input)
+    {
+        std::vector<uint8_t> output;
+        auto stream = (zlib().*create)(std::nullopt);
+        stream->onData([&output](const std::shared_ptr<ArrayBuffer> &chunk)
+                       { output.insert(output.end(), chunk->data(), chunk->data() + chunk->size()); });
+        for (size_t offset = 0; offset < input.size(); offset += kStreamChunkSize)
+            stream->write(makeBuffer(input.data() + offset, std::min(kStreamChunkSize, input.size() - offset)), std::nullopt, std::nullopt);
+        stream->end();
+        return makeBuffer(output);
+    }
+
+    OperationResult result(const CorpusEntry &entry, const char *operation, size_t compressedBytes,
+                           std::vector<double> latenciesUs)
+    {
+        OperationResult result;
+        result.corpus = entry.name;
+        result.operation = operation;
+        result.inputBytes = entry.data.size();
+        result.outputBytes = compressedBytes;
+        result.ratio = entry.data.empty() ? 0 : static_cast<double>(compressedBytes) / static_cast<double>(entry.data.size());
+        fillLatencies(result, std::move(latenciesUs));
+        return result;
+    }
+
+    void runOneShot(Report &report, const CorpusEntry &entry, const char *encodeName, const char *decodeName,
+                    SyncFn encode, SyncFn decode, double minTime)
+    {
+        auto input = makeBuffer(entry.data);
+        auto compressed = (zlib().*encode)(input, std::nullopt);
+        if (!equals((zlib().*decode)(compressed, std::nullopt), entry.data))
+            throw std::runtime_error(std::string(encodeName) + " round trip failed on " + entry.name);
+
+        report.results.push_back(result(entry, encodeName, compressed->size(), measure([&]()
+                                                                                       { (zlib().*encode)(input, std::nullopt); }, minTime)));
+        report.results.push_back(result(entry, decodeName, compressed->size(), measure([&]()
+                                                                                       { (zlib().*decode)(compressed, std::nullopt); }, minTime)));
+    }
+
+    void runStreams(Report &report, const CorpusEntry &entry, double minTime)
+    {
+        auto compressed = runStream(&HybridZlib::createDeflateStream, entry.data);
+        std::vector<uint8_t> compressedBytes(compressed->data(), compressed->data() + compressed->size());
+        if (!equals(runStream(&HybridZlib::createInflateStream, compressedBytes), entry.data))
+            throw std::runtime_error("stream round trip failed on " + entry.name);
+
+        report.results.push_back(result(entry, "deflateStream", compressed->size(), measure([&]()
+                                                                                            { runStream(&HybridZlib::createDeflateStream, entry.data); }, minTime)));
+        report.results.push_back(result(entry, "inflateStream", compressed->size(), measure([&]()
+                                                                                            { runStream(&HybridZlib::createInflateStream, compressedBytes); }, minTime)));
+    }
+
+    std::string timestamp()
+    {
+        std::time_t now = std::time(nullptr);
+        char buffer[32];
+        std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+        return buffer;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        Options options = parseOptions(argc, argv);
+        auto corpus = standardCorpus(options.corpusBytes);
+        if (!options.corpusDirectory.empty())
+            writeCorpus(corpus, options.corpusDirectory);
+
+        Report report;
+        report.generatedAt = timestamp();
+        report.corpusBytes = options.corpusBytes;
+        for (const auto &entry : corpus)
+        {
+            runOneShot(report, entry, "deflateSync", "inflateSync", &HybridZlib::deflateSync, &HybridZlib::inflateSync, options.minTime);
+            runOneShot(report, entry, "deflateRawSync", "inflateRawSync", &HybridZlib::deflateRawSync, &HybridZlib::inflateRawSync, options.minTime);
+            runOneShot(report, entry, "gzipSync", "gunzipSync", &HybridZlib::gzipSync, &HybridZlib::gunzipSync, options.minTime);
+            runStreams(report, entry, options.minTime);
+        }
+
+        std::string markdown = toMarkdown(report);
+        if (!options.jsonPath.empty())
+            writeFile(options.jsonPath, toJson(report));
+        if (!options.markdownPath.empty())
+            writeFile(options.markdownPath, markdown);
+        std::fputs(markdown.c_str(), stdout);
+
+        if (options.baselinePath.empty())
+            return 0;
+
+        Report baseline = parseReport(readFile(options.baselinePath));
+        auto regressions = findRegressions(baseline, report, kTrackedOperations, options.threshold);
+        if (regressions.empty())
+        {
+            std::printf("\nNo regressions over %.0f%% against %s\n", options.threshold * 100, options.baselinePath.c_str());
+            return 0;
+        }
+
+        std::printf("\nRegressions over %.0f%% against %s:\n", options.threshold * 100, options.baselinePath.c_str());
+        for (const auto &regression : regressions)
+        {
+            std::printf("  %s: %.1f MB/s -> %.1f MB/s (%.1f%%)\n", regression.key.c_str(), regression.baselineMBps,
+                        regression.currentMBps, regression.change * 100);
+        }
+        return 1;
+    }
+    catch (const std::exception &error)
+    {
+        std::fprintf(stderr, "zlib_regression: %s\n", error.what());
+        return 2;
+    }
+}
@@ -0,0 +1,317 @@
+#include "Report.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace margelo::nitro::rnzlib::bench
+{
+
+    namespace
+    {
+        double percentile(const std::vector<double> &sorted, double p)
+        {
+            if (sorted.empty())
+                return 0;
+            size_t index = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size()))) - 1;
+            return sorted[std::min(index, sorted.size() - 1)];
+        }
+
+        std::string escape(const std::string &value)
+        {
+            std::string out;
+            for (char c : value)
+            {
+                if (c == '"' || c == '\\')
+                    out += '\\';
+                out += c;
+            }
+            return out;
+        }
+
+        std::string number(double value, int precision)
+        {
+            char buffer[64];
+            std::snprintf(buffer, sizeof(buffer), "%.*f", precision, value);
+            return buffer;
+        }
+
+        /**
+         * Just enough JSON to read our own reports back: objects, arrays,
+         * strings without unicode escapes, numbers and literals.
+         */
+        class JsonReader
+        {
+        public:
+            explicit JsonReader(const std::string &text) : _text(text) {}
+
+            Report readReport()
+            {
+                Report report;
+                readObject([&](const std::string &key)
+                           {
+                               if (key == "generatedAt")
+                                   report.generatedAt = readString();
+                               else if (key == "corpusBytes")
+                                   report.corpusBytes = static_cast<size_t>(readNumber());
+                               else if (key == "results")
+                                   readArray([&]()
+                                             { report.results.push_back(readResult()); });
+                               else
+                                   skipValue(); });
+                return report;
+            }
+
+        private:
+            OperationResult readResult()
+            {
+                OperationResult result;
+                readObject([&](const std::string &key)
+                           {
+                               if (key == "corpus")
+                                   result.corpus = readString();
+                               else if (key == "operation")
+                                   result.operation = readString();
+                               else if (key == "inputBytes")
+                                   result.inputBytes = static_cast<size_t>(readNumber());
+                               else if (key == "outputBytes")
+                                   result.outputBytes = static_cast<size_t>(readNumber());
+                               else if (key == "iterations")
+                                   result.iterations = static_cast<size_t>(readNumber());
+                               else if (key == "throughputMBps")
+                                   result.throughputMBps = readNumber();
+                               else if (key == "ratio")
+                                   result.ratio = readNumber();
+                               else if (key == "p50Us")
+                                   result.p50Us = readNumber();
+                               else if (key == "p90Us")
+                                   result.p90Us = readNumber();
+                               else if (key == "p99Us")
+                                   result.p99Us = readNumber();
+                               else if (key == "maxUs")
+                                   result.maxUs = readNumber();
+                               else
+                                   skipValue(); });
+                return result;
+            }
+
+            template <typename OnKey>
+            void readObject(OnKey onKey)
+            {
+                expect('{');
+                if (peek() == '}')
+                {
+                    _pos++;
+                    return;
+                }
+                for (;;)
+                {
+                    std::string key = readString();
+                    expect(':');
+                    onKey(key);
+                    if (peek() == ',')
+                    {
+                        _pos++;
+                        continue;
+                    }
+                    expect('}');
+                    return;
+                }
+            }
+
+            template <typename OnItem>
+            void readArray(OnItem onItem)
+            {
+                expect('[');
+                if (peek() == ']')
+                {
+                    _pos++;
+                    return;
+                }
+                for (;;)
+                {
+                    onItem();
+                    if (peek() == ',')
+                    {
+                        _pos++;
+                        continue;
+                    }
+                    expect(']');
+                    return;
+                }
+            }
+
+            std::string readString()
+            {
+                expect('"');
+                std::string out;
+                while (_pos < _text.size() && _text[_pos] != '"')
+                {
+                    if (_text[_pos] == '\\' && _pos + 1 < _text.size())
+                        _pos++;
+                    out += _text[_pos++];
+                }
+                expect('"');
+                return out;
+            }
+
+            double readNumber()
+            {
+                skipWhitespace();
+                const char *start = _text.c_str() + _pos;
+                char *end = nullptr;
+                double value = std::strtod(start, &end);
+                if (end == start)
+                    fail("number");
+                _pos += static_cast<size_t>(end - start);
+                return value;
+            }
+
+            void skipValue()
+            {
+                char c = peek();
+                if (c == '{')
+                    readObject([&](const std::string &)
+                               { skipValue(); });
+                else if (c == '[')
+                    readArray([&]()
+                              { skipValue(); });
+                else if (c == '"')
+                    readString();
+                else if (std::isalpha(static_cast<unsigned char>(c)))
+                    while (_pos < _text.size() && std::isalpha(static_cast<unsigned char>(_text[_pos])))
+                        _pos++;
+                else
+                    readNumber();
+            }
+
+            char peek()
+            {
+                skipWhitespace();
+                return _pos < _text.size() ? _text[_pos] : '\0';
+            }
+
+            void expect(char c)
+            {
+                if (peek() != c)
+                    fail(std::string("'") + c + "'");
+                _pos++;
+            }
+
+            void skipWhitespace()
+            {
+                while (_pos < _text.size() && std::isspace(static_cast<unsigned char>(_text[_pos])))
+                    _pos++;
+            }
+
+            [[noreturn]] void fail(const std::string &what)
+            {
+                throw std::runtime_error("Malformed report: expected " + what + " at offset " + std::to_string(_pos));
+            }
+
+            const std::string &_text;
+            size_t _pos = 0;
+        };
+    } // namespace
+
+    void fillLatencies(OperationResult &result, std::vector<double> latenciesUs)
+    {
+        std::sort(latenciesUs.begin(), latenciesUs.end());
+        result.iterations = latenciesUs.size();
+        result.p50Us = percentile(latenciesUs, 0.50);
+        result.p90Us = percentile(latenciesUs, 0.90);
+        result.p99Us = percentile(latenciesUs, 0.99);
+        result.maxUs = latenciesUs.empty() ? 0 : latenciesUs.back();
+        result.throughputMBps = result.p50Us > 0 ? static_cast<double>(result.inputBytes) / result.p50Us : 0;
+    }
+
+    std::string toJson(const Report &report)
+    {
+        std::ostringstream out;
+        out << "{\n";
+        out << "  \"generatedAt\": \"" << escape(report.generatedAt) << "\",\n";
+        out << "  \"corpusBytes\": " << report.corpusBytes << ",\n";
+        out << "  \"results\": [";
+        for (size_t i = 0; i < report.results.size(); i++)
+        {
+            const auto &r = report.results[i];
+            out << (i == 0 ? "\n" : ",\n");
+            out << "    {\"corpus\": \"" << escape(r.corpus) << "\", \"operation\": \"" << escape(r.operation) << "\", "
+                << "\"inputBytes\": " << r.inputBytes << ", \"outputBytes\": " << r.outputBytes << ", "
+                << "\"iterations\": " << r.iterations << ", \"throughputMBps\": " << number(r.throughputMBps, 2) << ", "
+                << "\"ratio\": " << number(r.ratio, 4) << ", \"p50Us\": " << number(r.p50Us, 1) << ", "
+                << "\"p90Us\": " << number(r.p90Us, 1) << ", \"p99Us\": " << number(r.p99Us, 1) << ", "
+                << "\"maxUs\": " << number(r.maxUs, 1) << "}";
+        }
+        out << "\n  ]\n}\n";
+        return out.str();
+    }
+
+    std::string toMarkdown(const Report &report)
+    {
+        std::ostringstream out;
+        out << "# Zlib benchmark report\n\n";
+        out << "Generated " << report.generatedAt << ", " << report.corpusBytes << " bytes per corpus entry.\n\n";
+        out << "| Corpus | Operation | MB/s | Ratio | p50 (us) | p90 (us) | p99 (us) | Max (us) | Iterations |\n";
+        out << "|---|---|---:|---:|---:|---:|---:|---:|---:|\n";
+        for (const auto &r : report.results)
+        {
+            out << "| " << r.corpus << " | " << r.operation << " | " << number(r.throughputMBps, 1) << " | "
+                << number(r.ratio, 3) << " | " << number(r.p50Us, 1) << " | " << number(r.p90Us, 1) << " | "
+                << number(r.p99Us, 1) << " | " << number(r.maxUs, 1) << " | " << r.iterations << " |\n";
+        }
+        return out.str();
+    }
+
+    Report parseReport(const std::string &json)
+    {
+        return JsonReader(json).readReport();
+    }
+
+    std::vector<Regression> findRegressions(const Report &baseline, const Report &current,
+                                            const std::vector<std::string> &trackedOperations, double threshold)
+    {
+        std::unordered_map<std::string, const OperationResult *> previous;
+        for (const auto &result : baseline.results)
+            previous[result.key()] = &result;
+
+        std::vector<Regression> regressions;
+        for (const auto &result : current.results)
+        {
+            if (std::find(trackedOperations.begin(), trackedOperations.end(), result.operation) == trackedOperations.end())
+                continue;
+            auto it = previous.find(result.key());
+            if (it == previous.end() || it->second->throughputMBps <= 0)
+                continue;
+
+            double change = result.throughputMBps / it->second->throughputMBps - 1.0;
+            if (change < -threshold)
+                regressions.push_back({result.key(), it->second->throughputMBps, result.throughputMBps, change});
+        }
+        return regressions;
+    }
+
+    std::string readFile(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            throw std::runtime_error("Cannot read " + path);
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    void writeFile(const std::string &path, const std::string &contents)
+    {
+        std::ofstream file(path, std::ios::binary);
+        if (!file)
+            throw std::runtime_error("Cannot write " + path);
+        file << contents;
+    }
+
+} // namespace margelo::nitro::rnzlib::bench
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::rnzlib::bench
+{
+
+    // One operation measured on one corpus entry
+    struct OperationResult
+    {
+        std::string corpus;
+        std::string operation;
+        // Uncompressed and compressed size, whichever direction the operation runs
+        size_t inputBytes = 0;
+        size_t outputBytes = 0;
+        size_t iterations = 0;
+        // Uncompressed bytes per second at the median latency, in MB/s
+        double throughputMBps = 0;
+        // compressed / uncompressed
+        double ratio = 0;
+        double p50Us = 0;
+        double p90Us = 0;
+        double p99Us = 0;
+        double maxUs = 0;
+
+        std::string key() const { return corpus + "/" + operation; }
+    };
+
+    struct Report
+    {
+        std::string generatedAt;
+        size_t corpusBytes = 0;
+        std::vector<OperationResult> results;
+    };
+
+    // Summarizes per-iteration latencies (in microseconds) into percentiles
+    void fillLatencies(OperationResult &result, std::vector<double> latenciesUs);
+
+    std::string toJson(const Report &report);
+    std::string toMarkdown(const Report &report);
+
+    // Parses a report written by toJson(), throws std::runtime_error on malformed input
+    Report parseReport(const std::string &json);
+
+    struct Regression
+    {
+        std::string key;
+        double baselineMBps;
+        double currentMBps;
+        double change; // relative, negative = slower
+    };
+
+    /**
+     * Compares throughput of the tracked operations against a baseline and
+     * returns every result that got slower by more than `threshold` (0.1 = 10%).
+     * Entries missing from either side are ignored.
+     */
+    std::vector<Regression> findRegressions(const Report &baseline, const Report &current,
+                                            const std::vector<std::string> &trackedOperations, double threshold);
+
+    std::string readFile(const std::string &path);
+    void writeFile(const std::string &path, const std::string &contents);
+
+} // namespace margelo::nitro::rnzlib::bench
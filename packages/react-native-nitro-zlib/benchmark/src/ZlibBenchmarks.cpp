@@ -0,0 +1,364 @@
+#include <benchmark/benchmark.h>
+#include "BenchmarkSupport.hpp"
+#include "HybridZlib.hpp"
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace margelo::nitro;
+using namespace margelo::nitro::rnzlib;
+using namespace margelo::nitro::rnzlib::bench;
+
+namespace
+{
+    using SyncFn = std::shared_ptr<ArrayBuffer> (HybridZlib::*)(const std::shared_ptr<ArrayBuffer> &, const std::optional<ZlibOptions> &);
+    using AsyncFn = std::future<std::shared_ptr<ArrayBuffer>> (HybridZlib::*)(const std::shared_ptr<ArrayBuffer> &, const std::optional<ZlibOptions> &);
+    using StreamFn = std::shared_ptr<HybridZlibStreamSpec> (HybridZlib::*)(const std::optional<ZlibOptions> &);
+    using IntoFn = double (HybridZlib::*)(const std::shared_ptr<ArrayBuffer> &, const std::shared_ptr<ArrayBuffer> &,
+                                          std::optional<double>, const std::optional<ZlibOptions> &);
+
+    // An encoder/decoder pair exposed by HybridZlib, nullptr where a flavour doesn't exist
+    struct CodecApi
+    {
+        const char *encodeName;
+        const char *decodeName;
+        SyncFn encodeSync;
+        SyncFn decodeSync;
+        AsyncFn encodeAsync;
+        AsyncFn decodeAsync;
+        StreamFn encodeStream;
+        StreamFn decodeStream;
+        // Reference decoder used to verify round trips
+        SyncFn verify;
+    };
+
+    const std::vector<CodecApi> &codecApis()
+    {
+        static const std::vector<CodecApi> apis = {
+            {"deflate", "inflate", &HybridZlib::deflateSync, &HybridZlib::inflateSync, &HybridZlib::deflate,
+             &HybridZlib::inflate, &HybridZlib::createDeflateStream, &HybridZlib::createInflateStream,
+             &HybridZlib::inflateSync},
+            {"deflateRaw", "inflateRaw", &HybridZlib::deflateRawSync, &HybridZlib::inflateRawSync, &HybridZlib::deflateRaw,
+             &HybridZlib::inflateRaw, &HybridZlib::createDeflateRawStream, &HybridZlib::createInflateRawStream,
+             &HybridZlib::inflateRawSync},
+            {"gzip", "gunzip", &HybridZlib::gzipSync, &HybridZlib::gunzipSync, &HybridZlib::gzip,
+             &HybridZlib::gunzip, &HybridZlib::createGzipStream, &HybridZlib::createGunzipStream,
+             &HybridZlib::gunzipSync},
+            {"compress", "unzip", &HybridZlib::compressSync, &HybridZlib::unzipSync, &HybridZlib::compress,
+             &HybridZlib::unzip, nullptr, &HybridZlib::createUnzipStream, &HybridZlib::inflateSync},
+        };
+        return apis;
+    }
+
+    HybridZlib &zlib()
+    {
+        static auto instance = std::make_shared<HybridZlib>();
+        return *instance;
+    }
+
+    ZlibOptions levelOptions(int level, int strategy = Z_DEFAULT_STRATEGY)
+    {
+        auto options = emptyOptions();
+        options.level = level;
+        options.strategy = strategy;
+        return options;
+    }
+
+    // Collects allocation and RSS numbers around the timed loop
+    class ResourceProbe
+    {
+    public:
+        ResourceProbe()
+        {
+            resetPeakRss();
+            _before = allocationStats();
+        }
+
+        void report(benchmark::State &state, size_t bytesPerIteration)
+        {
+            AllocationStats after = allocationStats();
+            double iterations = static_cast<double>(state.iterations());
+
+            state.SetBytesProcessed(static_cast<int64_t>(bytesPerIteration) * state.iterations());
+            state.counters["MB/s"] = benchmark::Counter(static_cast<double>(bytesPerIteration) * iterations / 1e6,
+                                                        benchmark::Counter::kIsRate);
+            if (allocationTrackingEnabled() && iterations > 0)
+            {
+                state.counters["allocs"] = static_cast<double>(after.count - _before.count) / iterations;
+                state.counters["alloc_bytes"] = static_cast<double>(after.bytes - _before.bytes) / iterations;
+            }
+            state.counters["peak_rss_MB"] = static_cast<double>(peakRssBytes()) / 1e6;
+        }
+
+    private:
+        AllocationStats _before;
+    };
+
+    std::shared_ptr<ArrayBuffer> runStream(const std::shared_ptr<HybridZlibStreamSpec> &stream,
+                                           const std::vector<uint8_t> &input, size_t chunkSize)
+    {
+        std::vector<uint8_t> output;
+        stream->onData([&output](const std::shared_ptr<ArrayBuffer> &chunk)
+                       { output.insert(output.end(), chunk->data(), chunk->data() + chunk->size()); });
+
+        for (size_t offset = 0; offset < input.size(); offset += chunkSize)
+        {
+            size_t length = std::min(chunkSize, input.size() - offset);
+            stream->write(makeBuffer(input.data() + offset, length), std::nullopt, std::nullopt);
+        }
+        stream->end();
+        return makeBuffer(output);
+    }
+
+    void benchSyncEncode(benchmark::State &state, SyncFn encode, SyncFn verify, size_t size, ZlibOptions options)
+    {
+        const auto &payload = textPayload(size);
+        auto input = makeBuffer(payload);
+        auto compressed = (zlib().*encode)(input, options);
+        if (!equals((zlib().*verify)(compressed, std::nullopt), payload))
+        {
+            state.SkipWithError("round trip mismatch");
+            return;
+        }
+
+        ResourceProbe probe;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize((zlib().*encode)(input, options));
+        }
+        probe.report(state, size);
+        state.counters["ratio"] = static_cast<double>(compressed->size()) / static_cast<double>(size);
+    }
+
+    void benchSyncDecode(benchmark::State &state, SyncFn encode, SyncFn decode, size_t size)
+    {
+        const auto &payload = textPayload(size);
+        auto compressed = (zlib().*encode)(makeBuffer(payload), std::nullopt);
+        if (!equals((zlib().*decode)(compressed, std::nullopt), payload))
+        {
+            state.SkipWithError("round trip mismatch");
+            return;
+        }
+
+        ResourceProbe probe;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize((zlib().*decode)(compressed, std::nullopt));
+        }
+        probe.report(state, size);
+    }
+
+    // Decodes into one preallocated arena, like a caller that knows the output size
+    void benchInto(benchmark::State &state, SyncFn encode, IntoFn decode, size_t size)
+    {
+        const auto &payload = textPayload(size);
+        auto compressed = (zlib().*encode)(makeBuffer(payload), std::nullopt);
+        auto arena = makeBuffer(std::vector<uint8_t>(size));
+        if ((zlib().*decode)(compressed, arena, 0.0, std::nullopt) != static_cast<double>(size) || !equals(arena, payload))
+        {
+            state.SkipWithError("round trip mismatch");
+            return;
+        }
+
+        ResourceProbe probe;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize((zlib().*decode)(compressed, arena, 0.0, std::nullopt));
+        }
+        probe.report(state, size);
+    }
+
+    // Compress to base64 text and back, the shape of a blob stored in JSON
+    void benchBase64(benchmark::State &state, bool decoding, size_t size)
+    {
+        const auto &payload = textPayload(size);
+        auto input = makeBuffer(payload);
+        auto text = zlib().gzipToBase64(input, std::nullopt);
+        if (!equals(zlib().gunzipFromBase64(text, std::nullopt), payload))
+        {
+            state.SkipWithError("round trip mismatch");
+            return;
+        }
+
+        ResourceProbe probe;
+        for (auto _ : state)
+        {
+            if (decoding)
+                benchmark::DoNotOptimize(zlib().gunzipFromBase64(text, std::nullopt));
+            else
+                benchmark::DoNotOptimize(zlib().gzipToBase64(input, std::nullopt));
+        }
+        probe.report(state, size);
+    }
+
+    // Async gunzip into 64 KB segments, compare with async/gunzip at the same size
+    void benchSegmented(benchmark::State &state, size_t size)
+    {
+        const auto &payload = textPayload(size);
+        auto compressed = zlib().gzipSync(makeBuffer(payload), std::nullopt);
+        auto segments = zlib().gunzipSegmented(compressed, 64.0 * 1024, std::nullopt).get();
+        std::vector<uint8_t> joined;
+        for (const auto &segment : segments)
+            joined.insert(joined.end(), segment->data(), segment->data() + segment->size());
+        if (joined != payload)
+        {
+            state.SkipWithError("round trip mismatch");
+            return;
+        }
+
+        ResourceProbe probe;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(zlib().gunzipSegmented(compressed, 64.0 * 1024, std::nullopt).get());
+        }
+        probe.report(state, size);
+    }
+
+    // Async work runs on another thread, registered with UseRealTime() so rates use wall time
+    void benchAsync(benchmark::State &state, SyncFn encode, AsyncFn run, bool decoding, size_t size)
+    {
+        const auto &payload = textPayload(size);
+        auto input = decoding ? (zlib().*encode)(makeBuffer(payload), std::nullopt) : makeBuffer(payload);
+
+        ResourceProbe probe;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize((zlib().*run)(input, std::nullopt).get());
+        }
+        probe.report(state, size);
+    }
+
+    void benchStream(benchmark::State &state, const CodecApi &api, bool decoding, size_t size, size_t chunkSize)
+    {
+        const auto &payload = textPayload(size);
+        std::vector<uint8_t> input = payload;
+        if (decoding)
+        {
+            auto compressed = (zlib().*api.encodeSync)(makeBuffer(payload), std::nullopt);
+            input.assign(compressed->data(), compressed->data() + compressed->size());
+        }
+
+        StreamFn create = decoding ? api.decodeStream : api.encodeStream;
+        bool ok = false;
+        try
+        {
+            auto once = runStream((zlib().*create)(std::nullopt), input, chunkSize);
+            ok = decoding ? equals(once, payload) : equals((zlib().*api.verify)(once, std::nullopt), payload);
+        }
+        catch (const std::exception &)
+        {
+        }
+        if (!ok)
+        {
+            state.SkipWithError("stream output does not match the one-shot codec");
+            return;
+        }
+
+        ResourceProbe probe;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(runStream((zlib().*create)(std::nullopt), input, chunkSize));
+        }
+        probe.report(state, size);
+    }
+
+    void registerBenchmarks()
+    {
+        const auto sizes = payloadSizes();
+        const int levels[] = {1, 6, 9};
+        const size_t chunkSizes[] = {1024, 16 * 1024, 256 * 1024};
+
+        for (const auto &api : codecApis())
+        {
+            for (size_t size : sizes)
+            {
+                std::string suffix = "/size:" + formatSize(size);
+
+                for (int level : levels)
+                {
+                    benchmark::RegisterBenchmark(("sync/" + std::string(api.encodeName) + "Sync" + suffix + "/level:" + std::to_string(level)).c_str(),
+                                                 benchSyncEncode, api.encodeSync, api.verify, size, levelOptions(level));
+                }
+                if (api.decodeSync != nullptr)
+                {
+                    benchmark::RegisterBenchmark(("sync/" + std::string(api.decodeName) + "Sync" + suffix).c_str(),
+                                                 benchSyncDecode, api.encodeSync, api.decodeSync, size);
+                }
+
+                benchmark::RegisterBenchmark(("async/" + std::string(api.encodeName) + suffix).c_str(),
+                                             benchAsync, api.encodeSync, api.encodeAsync, false, size)
+                    ->UseRealTime();
+                if (api.decodeAsync != nullptr)
+                {
+                    benchmark::RegisterBenchmark(("async/" + std::string(api.decodeName) + suffix).c_str(),
+                                                 benchAsync, api.encodeSync, api.decodeAsync, true, size)
+                        ->UseRealTime();
+                }
+
+                for (size_t chunkSize : chunkSizes)
+                {
+                    if (chunkSize > size && chunkSize != chunkSizes[0])
+                        continue;
+                    std::string streamSuffix = suffix + "/chunk:" + formatSize(chunkSize);
+                    if (api.encodeStream != nullptr)
+                    {
+                        benchmark::RegisterBenchmark(("stream/" + std::string(api.encodeName) + streamSuffix).c_str(),
+                                                     [&api, size, chunkSize](benchmark::State &state)
+                                                     { benchStream(state, api, false, size, chunkSize); });
+                    }
+                    benchmark::RegisterBenchmark(("stream/" + std::string(api.decodeName) + streamSuffix).c_str(),
+                                                 [&api, size, chunkSize](benchmark::State &state)
+                                                 { benchStream(state, api, true, size, chunkSize); });
+                }
+            }
+        }
+
+        for (size_t size : sizes)
+        {
+            benchmark::RegisterBenchmark(("async/gunzipParallel/size:" + formatSize(size)).c_str(),
+                                         benchAsync, &HybridZlib::gzipSync, &HybridZlib::gunzipParallel, true, size)
+                ->UseRealTime();
+        }
+
+        for (size_t size : sizes)
+        {
+            benchmark::RegisterBenchmark(("into/inflateInto/size:" + formatSize(size)).c_str(),
+                                         benchInto, &HybridZlib::deflateSync, &HybridZlib::inflateInto, size);
+            benchmark::RegisterBenchmark(("into/gunzipInto/size:" + formatSize(size)).c_str(),
+                                         benchInto, &HybridZlib::gzipSync, &HybridZlib::gunzipInto, size);
+        }
+
+        for (size_t size : sizes)
+        {
+            benchmark::RegisterBenchmark(("base64/gzipToBase64/size:" + formatSize(size)).c_str(), benchBase64, false, size);
+            benchmark::RegisterBenchmark(("base64/gunzipFromBase64/size:" + formatSize(size)).c_str(), benchBase64, true, size);
+        }
+
+        for (size_t size : sizes)
+        {
+            benchmark::RegisterBenchmark(("segmented/gunzipSegmented/size:" + formatSize(size)).c_str(), benchSegmented, size)
+                ->UseRealTime();
+        }
+
+        const std::pair<const char *, int> strategies[] = {{"default", Z_DEFAULT_STRATEGY}, {"filtered", Z_FILTERED},
+                                                           {"huffmanOnly", Z_HUFFMAN_ONLY}, {"rle", Z_RLE}, {"fixed", Z_FIXED}};
+        for (const auto &[name, strategy] : strategies)
+        {
+            benchmark::RegisterBenchmark(("strategy/deflateSync/size:1M/strategy:" + std::string(name)).c_str(),
+                                         benchSyncEncode, &HybridZlib::deflateSync, &HybridZlib::inflateSync,
+                                         size_t(1) << 20, levelOptions(Z_DEFAULT_COMPRESSION, strategy));
+        }
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    registerBenchmarks();
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,50 @@
+//
+// Host stub of NitroModules/ArrayBuffer.hpp for the native benchmark build.
+// Mirrors the subset of the ArrayBuffer / NativeArrayBuffer API used in cpp/.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+
+namespace margelo::nitro
+{
+
+    using DeleteFn = std::function<void()>;
+
+    class ArrayBuffer
+    {
+    public:
+        virtual ~ArrayBuffer() = default;
+        virtual uint8_t *data() = 0;
+        virtual size_t size() const = 0;
+        virtual bool isOwner() const noexcept = 0;
+    };
+
+    class NativeArrayBuffer : public ArrayBuffer
+    {
+    public:
+        NativeArrayBuffer(uint8_t *data, size_t size, DeleteFn &&deleteFunc)
+            : _data(data), _size(size), _deleteFunc(std::move(deleteFunc)) {}
+
+        ~NativeArrayBuffer() override
+        {
+            if (_deleteFunc)
+                _deleteFunc();
+        }
+
+        uint8_t *data() override { return _data; }
+        size_t size() const override { return _size; }
+        bool isOwner() const noexcept override { return _deleteFunc != nullptr; }
+
+    private:
+        uint8_t *_data;
+        size_t _size;
+        DeleteFn _deleteFunc;
+    };
+
+} // namespace margelo::nitro
@@ -0,0 +1,47 @@
+//
+// Host stub of NitroModules/HybridObject.hpp for the native benchmark build.
+// Method registration is a no-op, HybridObjects are used as plain C++ classes.
+//
+
+#pragma once
+
+#include "ArrayBuffer.hpp"
+#include "JSIConverter.hpp"
+#include "NitroLogger.hpp"
+#include <memory>
+
+namespace margelo::nitro
+{
+
+    class Prototype
+    {
+    public:
+        template <typename Method>
+        void registerHybridMethod(const char *name, Method method) {}
+        template <typename Getter>
+        void registerHybridGetter(const char *name, Getter getter) {}
+        template <typename Setter>
+        void registerHybridSetter(const char *name, Setter setter) {}
+    };
+
+    class HybridObject : public std::enable_shared_from_this<HybridObject>
+    {
+    public:
+        explicit HybridObject(const char *name) : _name(name) {}
+        virtual ~HybridObject() = default;
+
+    protected:
+        virtual void loadHybridMethods() {}
+
+        template <typename Derived, typename Register>
+        void registerHybrids(Derived *self, Register &&registerFunc)
+        {
+            Prototype prototype;
+            registerFunc(prototype);
+        }
+
+    private:
+        const char *_name;
+    };
+
+} // namespace margelo::nitro
@@ -0,0 +1,54 @@
+//
+// Host stub of NitroModules/JSIConverter.hpp for the native benchmark build.
+// There is no JS runtime on the host: the jsi types and JSIConverter members
+// are declarations only, so generated converters compile but are never called.
+//
+
+#pragma once
+
+#include <string>
+
+namespace facebook::jsi
+{
+
+    class Runtime
+    {
+    };
+
+    class Object;
+
+    class Value
+    {
+    public:
+        Value() = default;
+        Value(const Object &);
+        bool isObject() const;
+        Object asObject(Runtime &runtime) const;
+        Object getObject(Runtime &runtime) const;
+    };
+
+    class Object
+    {
+    public:
+        explicit Object(Runtime &runtime);
+        Value getProperty(Runtime &runtime, const char *name) const;
+        template <typename T>
+        void setProperty(Runtime &runtime, const char *name, T &&value);
+    };
+
+} // namespace facebook::jsi
+
+namespace margelo::nitro
+{
+
+    namespace jsi = facebook::jsi;
+
+    template <typename T, typename Enable = void>
+    struct JSIConverter
+    {
+        static T fromJSI(jsi::Runtime &runtime, const jsi::Value &arg);
+        static jsi::Value toJSI(jsi::Runtime &runtime, const T &arg);
+        static bool canConvert(jsi::Runtime &runtime, const jsi::Value &value);
+    };
+
+} // namespace margelo::nitro
@@ -0,0 +1,9 @@
+//
+// Host stub of NitroModules/NitroDefines.hpp for the native benchmark build.
+//
+
+#pragma once
+
+#define SWIFT_PRIVATE
+#define SWIFT_NAME(name)
+#define CLOSED_ENUM
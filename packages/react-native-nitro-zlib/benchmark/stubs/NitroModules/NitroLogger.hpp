@@ -0,0 +1,34 @@
+//
+// Host stub of NitroModules/NitroLogger.hpp for the native benchmark build.
+//
+
+#pragma once
+
+#include <cstdio>
+
+namespace margelo::nitro
+{
+
+    enum class LogLevel
+    {
+        Debug,
+        Info,
+        Warning,
+        Error
+    };
+
+    class Logger
+    {
+    public:
+        template <typename... Args>
+        static void log(LogLevel level, const char *tag, const char *format, Args... args)
+        {
+            if (level < LogLevel::Warning)
+                return;
+            std::fprintf(stderr, "[%s] ", tag);
+            std::fprintf(stderr, format, args...);
+            std::fprintf(stderr, "\n");
+        }
+    };
+
+} // namespace margelo::nitro
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::rnzlib
+{
+
+    namespace base64
+    {
+        inline constexpr char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        // Character values for decoding: 0-63, or one of the markers below
+        inline constexpr int8_t INVALID = -1;
+        inline constexpr int8_t SPACE = -2;
+        inline constexpr int8_t PAD = -3;
+
+        struct DecodeTable
+        {
+            int8_t values[256];
+
+            constexpr DecodeTable() : values()
+            {
+                for (auto &value : values)
+                    value = INVALID;
+                for (int i = 0; i < 64; i++)
+                    values[static_cast<uint8_t>(ALPHABET[i])] = static_cast<int8_t>(i);
+                // URL-safe alphabet decodes too
+                values[static_cast<uint8_t>('-')] = 62;
+                values[static_cast<uint8_t>('_')] = 63;
+                values[static_cast<uint8_t>('=')] = PAD;
+                values[static_cast<uint8_t>(' ')] = SPACE;
+                values[static_cast<uint8_t>('\t')] = SPACE;
+                values[static_cast<uint8_t>('\r')] = SPACE;
+                values[static_cast<uint8_t>('\n')] = SPACE;
+            }
+        };
+
+        inline constexpr DecodeTable DECODE{};
+
+        inline size_t encodedLength(size_t bytes) { return (bytes + 2) / 3 * 4; }
+    } // namespace base64
+
+    /**
+     * Incremental base64 encoder (standard alphabet, padded). Bytes can be
+     * appended in pieces of any size; up to two are carried to the next call.
+     */
+    class Base64Encoder
+    {
+    public:
+        void reserve(size_t bytes) { _text.reserve(base64::encodedLength(bytes)); }
+
+        void append(const uint8_t *data, size_t length)
+        {
+            while (_carried > 0 && _carried < 3 && length > 0)
+            {
+                _carry[_carried++] = *data++;
+                length--;
+            }
+            if (_carried == 3)
+            {
+                encodeTriples(_carry, 3);
+                _carried = 0;
+            }
+
+            size_t whole = length - length % 3;
+            encodeTriples(data, whole);
+            for (size_t i = whole; i < length; i++)
+                _carry[_carried++] = data[i];
+        }
+
+        std::string finish()
+        {
+            if (_carried > 0)
+            {
+                uint32_t value = static_cast<uint32_t>(_carry[0]) << 16;
+                if (_carried == 2)
+                    value |= static_cast<uint32_t>(_carry[1]) << 8;
+                _text += base64::ALPHABET[(value >> 18) & 63];
+                _text += base64::ALPHABET[(value >> 12) & 63];
+                _text += _carried == 2 ? base64::ALPHABET[(value >> 6) & 63] : '=';
+                _text += '=';
+                _carried = 0;
+            }
+            return std::move(_text);
+        }
+
+    private:
+        void encodeTriples(const uint8_t *data, size_t length)
+        {
+            size_t start = _text.size();
+            _text.resize(start + length / 3 * 4);
+            char *out = _text.data() + start;
+            for (size_t i = 0; i < length; i += 3)
+            {
+                uint32_t value = (static_cast<uint32_t>(data[i]) << 16) |
+                                 (static_cast<uint32_t>(data[i + 1]) << 8) |
+                                 static_cast<uint32_t>(data[i + 2]);
+                out[0] = base64::ALPHABET[value >> 18];
+                out[1] = base64::ALPHABET[(value >> 12) & 63];
+                out[2] = base64::ALPHABET[(value >> 6) & 63];
+                out[3] = base64::ALPHABET[value & 63];
+                out += 4;
+            }
+        }
+
+        std::string _text;
+        uint8_t _carry[3] = {};
+        size_t _carried = 0;
+    };
+
+    /**
+     * Decodes standard or URL-safe base64. Padding is optional and ASCII
+     * whitespace (line breaks of MIME-style input) is skipped. Throws on any
+     * other character or a truncated final group.
+     */
+    inline std::vector<uint8_t> base64Decode(const char *text, size_t length)
+    {
+        std::vector<uint8_t> bytes(length / 4 * 3 + 3);
+        uint8_t *out = bytes.data();
+        const auto *in = reinterpret_cast<const uint8_t *>(text);
+        const int8_t *table = base64::DECODE.values;
+
+        size_t i = 0;
+        uint32_t quad[4];
+        size_t count = 0;
+        bool padded = false;
+        while (i < length)
+        {
+            // Fast path: four alphabet characters in a row
+            if (count == 0)
+            {
+                while (i + 4 <= length)
+                {
+                    int a = table[in[i]], b = table[in[i + 1]], c = table[in[i + 2]], d = table[in[i + 3]];
+                    if ((a | b | c | d) < 0)
+                        break;
+                    uint32_t value = (static_cast<uint32_t>(a) << 18) | (static_cast<uint32_t>(b) << 12) |
+                                     (static_cast<uint32_t>(c) << 6) | static_cast<uint32_t>(d);
+                    out[0] = static_cast<uint8_t>(value >> 16);
+                    out[1] = static_cast<uint8_t>(value >> 8);
+                    out[2] = static_cast<uint8_t>(value);
+                    out += 3;
+                    i += 4;
+                }
+                if (i == length)
+                    break;
+            }
+
+            int value = table[in[i++]];
+            if (value == base64::SPACE)
+                continue;
+            if (value == base64::PAD)
+            {
+                padded = true;
+                continue;
+            }
+            if (value == base64::INVALID || padded)
+                throw std::runtime_error("Invalid base64 input");
+
+            quad[count++] = static_cast<uint32_t>(value);
+            if (count == 4)
+            {
+                uint32_t group = (quad[0] << 18) | (quad[1] << 12) | (quad[2] << 6) | quad[3];
+                out[0] = static_cast<uint8_t>(group >> 16);
+                out[1] = static_cast<uint8_t>(group >> 8);
+                out[2] = static_cast<uint8_t>(group);
+                out += 3;
+                count = 0;
+            }
+        }
+
+        if (count == 1)
+            throw std::runtime_error("Invalid base64 input: truncated final group");
+        if (count >= 2)
+        {
+            uint32_t group = (quad[0] << 18) | (quad[1] << 12) | (count == 3 ? quad[2] << 6 : 0);
+            *out++ = static_cast<uint8_t>(group >> 16);
+            if (count == 3)
+                *out++ = static_cast<uint8_t>(group >> 8);
+        }
+
+        bytes.resize(static_cast<size_t>(out - bytes.data()));
+        return bytes;
+    }
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,194 @@
+#include "CompressedStore.hpp"
+#include "ZlibCodec.hpp"
+#include "ZlibTrace.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace margelo::nitro::rnzlib
+{
+    uint64_t CompressedStore::begin(const std::string &key)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        uint64_t write = _nextWrite++;
+        _writes[key] = write;
+        return write;
+    }
+
+    void CompressedStore::commit(const std::string &key, uint64_t write, const uint8_t *data, size_t length)
+    {
+        CodecParams params;
+        params.level = _limits.level;
+        auto compressed = runCodec<Direction::Deflate, Format::Raw>(data, length, params);
+        if (compressed->size() > _limits.maxCompressedBytes)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto pending = _writes.find(key);
+            if (pending != _writes.end() && pending->second == write)
+                _writes.erase(pending);
+            throw std::runtime_error("Value compresses to " + std::to_string(compressed->size()) +
+                                     " bytes, more than maxCompressedBytes");
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto pending = _writes.find(key);
+        if (pending == _writes.end() || pending->second != write)
+            return;
+        _writes.erase(pending);
+
+        auto existing = _entries.find(key);
+        if (existing != _entries.end())
+            erase(existing);
+
+        _lru.push_front(key);
+        Entry &entry = _entries[key];
+        entry.compressed = std::move(compressed);
+        entry.originalSize = length;
+        entry.lru = _lru.begin();
+        _compressedBytes += entry.compressed->size();
+        _originalBytes += length;
+        trim();
+    }
+
+    std::optional<std::shared_ptr<ArrayBuffer>> CompressedStore::get(const std::string &key)
+    {
+        std::shared_ptr<ArrayBuffer> compressed;
+        size_t originalSize = 0;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _entries.find(key);
+            if (it == _entries.end())
+                return std::nullopt;
+
+            Entry &entry = it->second;
+            _lru.splice(_lru.begin(), _lru, entry.lru);
+            if (entry.hotLru.has_value())
+            {
+                _hotLru.splice(_hotLru.begin(), _hotLru, *entry.hotLru);
+                // Callers get their own copy, the hot one stays intact
+                auto *copy = new uint8_t[entry.originalSize];
+                std::copy(entry.hot.begin(), entry.hot.end(), copy);
+                return std::make_shared<NativeArrayBuffer>(copy, entry.originalSize, [copy]()
+                                                           { delete[] copy; });
+            }
+            compressed = entry.compressed;
+            originalSize = entry.originalSize;
+        }
+
+        // The size is known, so inflate straight into a buffer of that size
+        auto *data = new uint8_t[originalSize > 0 ? originalSize : 1];
+        auto result = std::make_shared<NativeArrayBuffer>(data, originalSize, [data]()
+                                                          { delete[] data; });
+        runCodecInto<Direction::Inflate, Format::Raw>(compressed->data(), compressed->size(), CodecParams{}, data, originalSize);
+
+        if (originalSize == 0 || originalSize > _limits.maxHotBytes)
+            return result;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _entries.find(key);
+        // Replaced or removed while inflating, or made hot by another reader
+        if (it == _entries.end() || it->second.compressed != compressed || it->second.hotLru.has_value())
+            return result;
+
+        Entry &entry = it->second;
+        entry.hot.assign(data, data + originalSize);
+        _hotLru.push_front(key);
+        entry.hotLru = _hotLru.begin();
+        _hotBytes += originalSize;
+        trimHot();
+        return result;
+    }
+
+    bool CompressedStore::has(const std::string &key)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _entries.count(key) > 0;
+    }
+
+    bool CompressedStore::remove(const std::string &key)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        bool pending = _writes.erase(key) > 0;
+        auto it = _entries.find(key);
+        if (it == _entries.end())
+            return pending;
+        erase(it);
+        return true;
+    }
+
+    void CompressedStore::clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _writes.clear();
+        _entries.clear();
+        _lru.clear();
+        _hotLru.clear();
+        _compressedBytes = _originalBytes = _hotBytes = 0;
+    }
+
+    size_t CompressedStore::size()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _entries.size();
+    }
+
+    size_t CompressedStore::compressedBytes()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _compressedBytes;
+    }
+
+    size_t CompressedStore::originalBytes()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _originalBytes;
+    }
+
+    size_t CompressedStore::hotBytes()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _hotBytes;
+    }
+
+    size_t CompressedStore::evictions()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _evictions;
+    }
+
+    void CompressedStore::erase(std::unordered_map<std::string, Entry>::iterator it)
+    {
+        Entry &entry = it->second;
+        dropHot(entry);
+        _compressedBytes -= entry.compressed->size();
+        _originalBytes -= entry.originalSize;
+        _lru.erase(entry.lru);
+        _entries.erase(it);
+    }
+
+    void CompressedStore::dropHot(Entry &entry)
+    {
+        if (!entry.hotLru.has_value())
+            return;
+        _hotBytes -= entry.originalSize;
+        _hotLru.erase(*entry.hotLru);
+        entry.hotLru.reset();
+        std::vector<uint8_t>().swap(entry.hot);
+    }
+
+    void CompressedStore::trim()
+    {
+        while (_compressedBytes > _limits.maxCompressedBytes && !_lru.empty())
+        {
+            ZLIB_LOG_DEBUG("CompressedStore", "Evicting %s", _lru.back().c_str());
+            erase(_entries.find(_lru.back()));
+            _evictions++;
+        }
+    }
+
+    void CompressedStore::trimHot()
+    {
+        while (_hotBytes > _limits.maxHotBytes && !_hotLru.empty())
+            dropHot(_entries.find(_hotLru.back())->second);
+    }
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace margelo::nitro::rnzlib
+{
+
+    /**
+     * Key/value store keeping values as raw deflate in native memory.
+     *
+     * Two LRU tiers: every entry is held compressed and counts against
+     * maxCompressedBytes; recently read entries are also kept decompressed
+     * up to maxHotBytes so repeated reads skip inflate. Thread-safe; inflate
+     * and deflate run outside the lock.
+     */
+    class CompressedStore
+    {
+    public:
+        struct Limits
+        {
+            size_t maxCompressedBytes = 64 * 1024 * 1024;
+            size_t maxHotBytes = 8 * 1024 * 1024;
+            int level = -1;
+        };
+
+        explicit CompressedStore(const Limits &limits) : _limits(limits) {}
+
+        // Reserves a write slot for key; a later remove() or begin() for the
+        // same key makes the earlier write a no-op
+        uint64_t begin(const std::string &key);
+
+        // Compresses and stores, unless the write was superseded. Throws when
+        // the value alone is larger than maxCompressedBytes.
+        void commit(const std::string &key, uint64_t write, const uint8_t *data, size_t length);
+
+        std::optional<std::shared_ptr<ArrayBuffer>> get(const std::string &key);
+        bool has(const std::string &key);
+        bool remove(const std::string &key);
+        void clear();
+
+        size_t size();
+        size_t compressedBytes();
+        size_t originalBytes();
+        size_t hotBytes();
+        size_t evictions();
+
+    private:
+        using Order = std::list<std::string>;
+
+        struct Entry
+        {
+            // Native-owned, never handed to JS
+            std::shared_ptr<ArrayBuffer> compressed;
+            size_t originalSize = 0;
+            Order::iterator lru;
+            // Decompressed copy while in the hot tier
+            std::vector<uint8_t> hot;
+            std::optional<Order::iterator> hotLru;
+        };
+
+        void erase(std::unordered_map<std::string, Entry>::iterator it);
+        void dropHot(Entry &entry);
+        void trim();
+        void trimHot();
+
+        Limits _limits;
+        std::mutex _mutex;
+        std::unordered_map<std::string, Entry> _entries;
+        // Most recently used first
+        Order _lru;
+        Order _hotLru;
+        // Latest write per key that has not landed yet
+        std::unordered_map<std::string, uint64_t> _writes;
+        uint64_t _nextWrite = 1;
+
+        size_t _compressedBytes = 0;
+        size_t _originalBytes = 0;
+        size_t _hotBytes = 0;
+        size_t _evictions = 0;
+    };
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,92 @@
+#include "CompressibilityProbe.hpp"
+#include <zlib.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace margelo::nitro::rnzlib
+{
+
+    namespace
+    {
+        constexpr size_t SAMPLE_COUNT = 4;
+        constexpr size_t SAMPLE_SIZE = 4 * 1024;
+        constexpr size_t TRIAL_SIZE = 4 * 1024;
+
+        // Below this many bits per byte the input is compressible enough to skip the trial
+        constexpr double LOW_ENTROPY = 6.0;
+        // Level 1 trial ratios at or above these pick stored blocks / level 1
+        constexpr double STORED_RATIO = 0.98;
+        constexpr double FAST_RATIO = 0.90;
+
+        double sampledEntropy(const uint8_t *data, size_t length)
+        {
+            uint32_t histogram[256] = {};
+            size_t total = 0;
+
+            size_t sampleSize = std::min(SAMPLE_SIZE, length / SAMPLE_COUNT);
+            for (size_t i = 0; i < SAMPLE_COUNT; i++)
+            {
+                const uint8_t *sample = data + (length - sampleSize) * i / (SAMPLE_COUNT - 1);
+                for (size_t j = 0; j < sampleSize; j++)
+                    histogram[sample[j]]++;
+                total += sampleSize;
+            }
+
+            double entropy = 0;
+            for (uint32_t count : histogram)
+            {
+                if (count == 0)
+                    continue;
+                double p = static_cast<double>(count) / static_cast<double>(total);
+                entropy -= p * std::log2(p);
+            }
+            return entropy;
+        }
+
+        // Raw deflate at level 1 on a slice from the middle of the input
+        double trialRatio(const uint8_t *data, size_t length)
+        {
+            size_t size = std::min(TRIAL_SIZE, length);
+            const uint8_t *trial = data + (length - size) / 2;
+
+            z_stream strm;
+            std::memset(&strm, 0, sizeof(strm));
+            // Small window and memLevel: the trial only looks at TRIAL_SIZE bytes
+            if (deflateInit2(&strm, 1, Z_DEFLATED, -12, 6, Z_DEFAULT_STRATEGY) != Z_OK)
+                return 0;
+
+            uint8_t out[TRIAL_SIZE + 256];
+            strm.next_in = const_cast<Bytef *>(trial);
+            strm.avail_in = static_cast<uInt>(size);
+            strm.next_out = out;
+            strm.avail_out = sizeof(out);
+            int ret = ::deflate(&strm, Z_FINISH);
+            size_t produced = strm.total_out;
+            deflateEnd(&strm);
+
+            if (ret != Z_STREAM_END)
+                return 1.0; // did not even fit: incompressible
+            return static_cast<double>(produced) / static_cast<double>(size);
+        }
+    } // namespace
+
+    CompressibilityProbe::Decision CompressibilityProbe::decide(const uint8_t *data, size_t length, int requestedLevel)
+    {
+        Decision decision{requestedLevel, 0, 0};
+        if (length < MIN_INPUT || requestedLevel == 0)
+            return decision;
+
+        decision.entropy = sampledEntropy(data, length);
+        if (decision.entropy < LOW_ENTROPY)
+            return decision;
+
+        decision.trialRatio = trialRatio(data, length);
+        if (decision.trialRatio >= STORED_RATIO)
+            decision.level = 0;
+        else if (decision.trialRatio >= FAST_RATIO && requestedLevel != 1)
+            decision.level = 1;
+        return decision;
+    }
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace margelo::nitro::rnzlib
+{
+
+    /**
+     * Cheap look at a deflate input before committing to a compression level.
+     *
+     * Byte entropy is computed over a few samples spread across the input.
+     * Clearly compressible data (low entropy) keeps the requested level right
+     * away; otherwise a few KB from the middle are trial-compressed at level 1.
+     * Data that does not shrink (JPEG, video, already deflated blobs) is
+     * written as stored blocks, data that barely shrinks drops to level 1.
+     */
+    class CompressibilityProbe
+    {
+    public:
+        struct Decision
+        {
+            int level;
+            // Bits per byte over the sampled bytes, 0..8
+            double entropy;
+            // Level 1 output/input on the trial sample, 0 if no trial was needed
+            double trialRatio;
+        };
+
+        // Inputs smaller than this are compressed as requested without probing
+        static constexpr size_t MIN_INPUT = 8 * 1024;
+
+        static Decision decide(const uint8_t *data, size_t length, int requestedLevel);
+    };
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace margelo::nitro::rnzlib
+{
+
+    enum class DetectedFormat
+    {
+        Gzip,
+        Zlib,
+        Raw,
+        NeedMoreInput // fewer than two bytes and they could still start a header
+    };
+
+    /**
+     * Looks at the first two bytes of a compressed payload: gzip magic
+     * (1f 8b), a valid zlib CMF/FLG pair (deflate method, window <= 32K,
+     * FCHECK multiple of 31), or anything else as raw deflate.
+     *
+     * A raw stream whose first bytes happen to pass the zlib check is
+     * misdetected; that is about 1 in 1000 of arbitrary byte pairs and far
+     * rarer for real deflate output.
+     */
+    inline DetectedFormat sniffFormat(const uint8_t *data, size_t length)
+    {
+        if (length == 0)
+            return DetectedFormat::NeedMoreInput;
+
+        uint8_t cmf = data[0];
+        bool couldBeGzip = cmf == 0x1f;
+        // CM = 8 (deflate), CINFO <= 7 (32K window)
+        bool couldBeZlib = (cmf & 0x0f) == 8 && (cmf >> 4) <= 7;
+        if (length == 1)
+            return couldBeGzip || couldBeZlib ? DetectedFormat::NeedMoreInput : DetectedFormat::Raw;
+
+        uint8_t flg = data[1];
+        if (couldBeGzip && flg == 0x8b)
+            return DetectedFormat::Gzip;
+        if (couldBeZlib && ((cmf << 8) | flg) % 31 == 0)
+            return DetectedFormat::Zlib;
+        return DetectedFormat::Raw;
+    }
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,31 @@
+// HybridAbortToken.hpp
+
+#pragma once
+
+#include "HybridAbortTokenSpec.hpp"
+#include <atomic>
+#include <memory>
+
+namespace margelo::nitro::rnzlib
+{
+
+    /**
+     * Passed as ZlibOptions.signal. abort() flips a flag that running codecs
+     * poll between steps, so work already on a worker thread stops too. The
+     * flag is shared with the codec and outlives the JS handle.
+     */
+    class HybridAbortToken : public HybridAbortTokenSpec
+    {
+    public:
+        HybridAbortToken() : HybridObject(TAG), _flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+        bool getAborted() override { return _flag->load(std::memory_order_relaxed); }
+        void abort() override { _flag->store(true, std::memory_order_relaxed); }
+
+        std::shared_ptr<const std::atomic<bool>> flag() const { return _flag; }
+
+    private:
+        std::shared_ptr<std::atomic<bool>> _flag;
+    };
+
+} // namespace margelo::nitro::rnzlib
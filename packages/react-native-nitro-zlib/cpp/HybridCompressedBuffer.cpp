@@ -0,0 +1,28 @@
+#include "HybridCompressedBuffer.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace margelo::nitro::rnzlib
+{
+    std::shared_ptr<ArrayBuffer> HybridCompressedBuffer::toArrayBuffer()
+    {
+        size_t size = _bytes->size();
+        auto *data = new uint8_t[size > 0 ? size : 1];
+        if (size > 0)
+            std::memcpy(data, _bytes->data(), size);
+        return std::make_shared<NativeArrayBuffer>(data, size, [data]()
+                                                   { delete[] data; });
+    }
+
+    std::shared_ptr<ArrayBuffer> HybridCompressedBuffer::bytesOf(const ZlibInput &input)
+    {
+        if (const auto *buffer = std::get_if<std::shared_ptr<ArrayBuffer>>(&input))
+            return *buffer;
+
+        auto handle = std::dynamic_pointer_cast<HybridCompressedBuffer>(std::get<std::shared_ptr<HybridCompressedBufferSpec>>(input));
+        if (!handle)
+            throw std::runtime_error("Expected an ArrayBuffer or a CompressedBuffer from this module");
+        return handle->_bytes;
+    }
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,38 @@
+// HybridCompressedBuffer.hpp
+
+#pragma once
+
+#include "HybridCompressedBufferSpec.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+#include <memory>
+#include <variant>
+
+namespace margelo::nitro::rnzlib
+{
+
+    // `ArrayBuffer | CompressedBuffer` parameters
+    using ZlibInput = std::variant<std::shared_ptr<ArrayBuffer>, std::shared_ptr<HybridCompressedBufferSpec>>;
+
+    /**
+     * Codec output kept in native memory. JS sees only the handle and its
+     * byteLength; the bytes are copied into an ArrayBuffer only when
+     * toArrayBuffer() is called, and passing the handle back into a zlib
+     * method reads them in place.
+     */
+    class HybridCompressedBuffer : public HybridCompressedBufferSpec
+    {
+    public:
+        explicit HybridCompressedBuffer(const std::shared_ptr<ArrayBuffer> &bytes) : HybridObject(TAG), _bytes(bytes) {}
+
+        double getByteLength() override { return static_cast<double>(_bytes->size()); }
+        std::shared_ptr<ArrayBuffer> toArrayBuffer() override;
+
+        // The bytes behind either alternative, never copied
+        static std::shared_ptr<ArrayBuffer> bytesOf(const ZlibInput &input);
+
+    private:
+        // Native-owned and never handed out, so it can't change under the handle
+        std::shared_ptr<ArrayBuffer> _bytes;
+    };
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,55 @@
+#include "HybridCompressedStore.hpp"
+#include "InputView.hpp"
+#include "WorkerPool.hpp"
+#include "ZlibMetrics.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace margelo::nitro::rnzlib
+{
+    namespace
+    {
+        CompressedStore::Limits limitsFrom(const std::optional<CompressedStoreOptions> &options)
+        {
+            CompressedStore::Limits limits;
+            if (!options.has_value())
+                return limits;
+            if (options->maxCompressedBytes.has_value())
+                limits.maxCompressedBytes = static_cast<size_t>(std::max(0.0, options->maxCompressedBytes.value()));
+            if (options->maxHotBytes.has_value())
+                limits.maxHotBytes = static_cast<size_t>(std::max(0.0, options->maxHotBytes.value()));
+            if (options->level.has_value())
+                limits.level = static_cast<int>(options->level.value());
+            if (limits.level < Z_DEFAULT_COMPRESSION || limits.level > Z_BEST_COMPRESSION)
+                throw std::runtime_error("CompressedStore level must be -1..9");
+            return limits;
+        }
+    } // namespace
+
+    HybridCompressedStore::HybridCompressedStore(const std::optional<CompressedStoreOptions> &options)
+        : HybridObject(TAG), _store(std::make_shared<CompressedStore>(limitsFrom(options)))
+    {
+    }
+
+    std::future<void> HybridCompressedStore::put(const std::string &key, const std::shared_ptr<ArrayBuffer> &data)
+    {
+        auto input = inputView(data, std::nullopt, std::nullopt);
+        auto bytes = std::make_shared<std::vector<uint8_t>>(input.data, input.data + input.size);
+        uint64_t write = _store->begin(key);
+        return WorkerPool::shared().submit([store = _store, key, write, bytes]()
+                                           {
+                                               MetricsScope metrics(MetricOp::storePut, bytes->size());
+                                               store->commit(key, write, bytes->data(), bytes->size()); });
+    }
+
+    std::optional<std::shared_ptr<ArrayBuffer>> HybridCompressedStore::get(const std::string &key)
+    {
+        MetricsScope metrics(MetricOp::storeGet, 0);
+        auto value = _store->get(key);
+        if (value.has_value())
+            metrics.setBytesOut(value.value()->size());
+        return value;
+    }
+
+} // namespace margelo::nitro::rnzlib
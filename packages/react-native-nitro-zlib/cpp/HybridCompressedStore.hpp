@@ -0,0 +1,44 @@
+// HybridCompressedStore.hpp
+
+#pragma once
+
+#include "HybridCompressedStoreSpec.hpp"
+#include "CompressedStoreOptions.hpp"
+#include "CompressedStore.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+#include <zlib.h>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace margelo::nitro::rnzlib
+{
+
+    /**
+     * JS handle for a CompressedStore. put() copies the value on the JS
+     * thread and compresses it on the shared WorkerPool; get() inflates on
+     * the calling thread unless the entry is in the hot tier.
+     */
+    class HybridCompressedStore : public HybridCompressedStoreSpec
+    {
+    public:
+        explicit HybridCompressedStore(const std::optional<CompressedStoreOptions> &options);
+
+        double getSize() override { return static_cast<double>(_store->size()); }
+        double getCompressedBytes() override { return static_cast<double>(_store->compressedBytes()); }
+        double getOriginalBytes() override { return static_cast<double>(_store->originalBytes()); }
+        double getHotBytes() override { return static_cast<double>(_store->hotBytes()); }
+        double getEvictions() override { return static_cast<double>(_store->evictions()); }
+
+        std::future<void> put(const std::string &key, const std::shared_ptr<ArrayBuffer> &data) override;
+        std::optional<std::shared_ptr<ArrayBuffer>> get(const std::string &key) override;
+        bool has(const std::string &key) override { return _store->has(key); }
+        bool remove(const std::string &key) override { return _store->remove(key); }
+        void clear() override { _store->clear(); }
+
+    private:
+        // Shared with queued put() jobs, which may outlive this object
+        std::shared_ptr<CompressedStore> _store;
+    };
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,215 @@
+#include "HybridContentDecoder.hpp"
+#include "FormatSniffer.hpp"
+#include "InputView.hpp"
+#include "ZlibCodec.hpp"
+#include "ZlibTrace.hpp"
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <stdexcept>
+
+namespace margelo::nitro::rnzlib
+{
+    HybridContentDecoder::HybridContentDecoder(bool gzip, const std::shared_ptr<ArrayBuffer> &ring)
+        : HybridObject(TAG), _gzip(gzip), _ring(ring), _ringSize(ring ? ring->size() : 0)
+    {
+        if (_ringSize == 0)
+            throw std::runtime_error("ContentDecoder needs a non-empty ring buffer");
+    }
+
+    HybridContentDecoder::~HybridContentDecoder()
+    {
+        if (_initialized)
+            inflateEnd(&_zstream);
+    }
+
+    std::shared_ptr<HybridContentDecoder> HybridContentDecoder::create(const std::string &encoding, const std::shared_ptr<ArrayBuffer> &ring)
+    {
+        std::string name;
+        for (char c : encoding)
+        {
+            if (c != ' ' && c != '\t')
+                name += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+
+        if (name == "gzip" || name == "x-gzip")
+            return std::make_shared<HybridContentDecoder>(true, ring);
+        if (name == "deflate")
+            return std::make_shared<HybridContentDecoder>(false, ring);
+        throw std::runtime_error("Unsupported Content-Encoding: " + encoding);
+    }
+
+    void HybridContentDecoder::initialize(int windowBits)
+    {
+        int ret = inflateInit2(&_zstream, windowBits);
+        if (ret != Z_OK)
+            throw std::runtime_error("Failed to initialize content decoder: " + std::string(zError(ret)));
+        _initialized = true;
+    }
+
+    double HybridContentDecoder::write(const std::shared_ptr<ArrayBuffer> &chunk, std::optional<double> byteOffset, std::optional<double> byteLength)
+    {
+        auto input = inputView(chunk, byteOffset, byteLength);
+        feed(input.data, input.size);
+        return static_cast<double>(_readable);
+    }
+
+    double HybridContentDecoder::consume(double bytes)
+    {
+        if (bytes < 0 || static_cast<size_t>(bytes) > _readable)
+            throw std::runtime_error("consume() past the readable bytes");
+
+        _readOffset = (_readOffset + static_cast<size_t>(bytes)) % _ringSize;
+        _readable -= static_cast<size_t>(bytes);
+        // An empty ring restarts at 0, so the next output is one contiguous run
+        if (_readable == 0)
+            _readOffset = 0;
+
+        drain();
+        return static_cast<double>(_readable);
+    }
+
+    void HybridContentDecoder::end()
+    {
+        if (!_pending.empty() || _outputStalled)
+            throw std::runtime_error("Decoded data is still waiting for ring space, consume() it before end()");
+
+        // An empty body (HEAD, 204, 304) is fine, a partial header or stream is not
+        bool empty = !_initialized && _header.empty();
+        if (!empty && !_finished && !_memberEnded)
+            throw std::runtime_error("Content ended before the compressed stream was complete");
+        _finished = true;
+    }
+
+    void HybridContentDecoder::feed(const uint8_t *data, size_t length)
+    {
+        if (_finished)
+            return;
+
+        if (!_initialized)
+        {
+            if (_gzip)
+            {
+                initialize(15 + 16);
+            }
+            else
+            {
+                // Collect up to two bytes so a header split across writes is still recognized
+                while (_header.size() < 2 && length > 0)
+                {
+                    _header.push_back(*data++);
+                    length--;
+                }
+                auto format = sniffFormat(_header.data(), _header.size());
+                if (format == DetectedFormat::NeedMoreInput)
+                    return;
+                initialize(sniffedWindowBits(format));
+
+                size_t used = decode(_header.data(), _header.size());
+                _pending.assign(_header.begin() + used, _header.end());
+                _header.clear();
+            }
+        }
+
+        // Keep the byte order once something is queued
+        if (!_pending.empty())
+        {
+            _pending.insert(_pending.end(), data, data + length);
+            drain();
+            return;
+        }
+
+        size_t used = decode(data, length);
+        if (used < length)
+            _pending.assign(data + used, data + length);
+    }
+
+    void HybridContentDecoder::drain()
+    {
+        if (!_initialized || (_pending.empty() && !_outputStalled))
+            return;
+        size_t used = decode(_pending.data(), _pending.size());
+        _pending.erase(_pending.begin(), _pending.begin() + used);
+    }
+
+    uint8_t *HybridContentDecoder::writeRegion(size_t &available)
+    {
+        uint8_t *ring = _ring->data();
+        if (ring == nullptr)
+            throw std::runtime_error("The ring buffer is no longer available");
+
+        size_t writeOffset = (_readOffset + _readable) % _ringSize;
+        if (_readable == _ringSize)
+            available = 0;
+        else if (writeOffset >= _readOffset)
+            available = _ringSize - writeOffset;
+        else
+            available = _readOffset - writeOffset;
+        return ring + writeOffset;
+    }
+
+    // Inflates until the input is used up or the ring is full, returns the bytes consumed
+    size_t HybridContentDecoder::decode(const uint8_t *data, size_t length)
+    {
+        size_t consumed = 0;
+        while (!_finished)
+        {
+            if (_memberEnded)
+            {
+                if (consumed == length)
+                    break;
+                // Anything but another gzip member is trailing data (often zero padding)
+                if (data[consumed] != 0x1f)
+                {
+                    ZLIB_LOG_DEBUG("ContentDecoder", "Ignoring %zu trailing bytes", length - consumed);
+                    _finished = true;
+                    break;
+                }
+                inflateReset(&_zstream);
+                _memberEnded = false;
+            }
+            if (consumed == length && !_outputStalled)
+                break;
+
+            size_t available = 0;
+            uint8_t *out = writeRegion(available);
+            if (available == 0)
+                break;
+
+            uInt in = static_cast<uInt>(std::min<size_t>(length - consumed, UINT_MAX));
+            _zstream.next_in = const_cast<Bytef *>(data + consumed);
+            _zstream.avail_in = in;
+            _zstream.next_out = out;
+            _zstream.avail_out = static_cast<uInt>(std::min<size_t>(available, UINT_MAX));
+            uInt outBefore = _zstream.avail_out;
+
+            int ret = inflate(&_zstream, Z_NO_FLUSH);
+            consumed += in - _zstream.avail_in;
+            _readable += outBefore - _zstream.avail_out;
+            _outputStalled = _zstream.avail_out == 0;
+
+            if (ret == Z_STREAM_END)
+            {
+                _outputStalled = false;
+                if (_gzip)
+                    _memberEnded = true;
+                else
+                    _finished = true;
+                continue;
+            }
+            // No progress possible: more input needed
+            if (ret == Z_BUF_ERROR)
+                break;
+            if (ret != Z_OK)
+            {
+                std::string message = "Content decoding failed: ";
+                message += _zstream.msg != nullptr ? _zstream.msg : zError(ret);
+                throw std::runtime_error(message);
+            }
+        }
+
+        // Bytes after the end of the stream are dropped
+        return _finished ? length : consumed;
+    }
+
+} // namespace margelo::nitro::rnzlib
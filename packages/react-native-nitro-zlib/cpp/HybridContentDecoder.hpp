@@ -0,0 +1,69 @@
+// HybridContentDecoder.hpp
+
+#pragma once
+
+#include "HybridContentDecoderSpec.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+#include <zlib.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::rnzlib
+{
+
+    /**
+     * Incremental decoder for HTTP response bodies (Content-Encoding gzip or
+     * deflate). Network chunks are written as they arrive, in slices of any
+     * size, and the decoded bytes land in a ring buffer owned by the caller:
+     * readable bytes start at readOffset and wrap to the start of the ring.
+     *
+     * `deflate` is accepted with or without the zlib header, decided on the
+     * first two bytes. `gzip` bodies may hold several members back to back.
+     * Input that doesn't fit the ring yet is kept natively until consume()
+     * frees space.
+     */
+    class HybridContentDecoder : public HybridContentDecoderSpec
+    {
+    public:
+        HybridContentDecoder(bool gzip, const std::shared_ptr<ArrayBuffer> &ring);
+        ~HybridContentDecoder() override;
+
+        // Accepts gzip, x-gzip and deflate, throws for anything else
+        static std::shared_ptr<HybridContentDecoder> create(const std::string &encoding, const std::shared_ptr<ArrayBuffer> &ring);
+
+        double getReadable() override { return static_cast<double>(_readable); }
+        double getReadOffset() override { return static_cast<double>(_readOffset); }
+        bool getFinished() override { return _finished || _memberEnded; }
+
+        double write(const std::shared_ptr<ArrayBuffer> &chunk, std::optional<double> byteOffset, std::optional<double> byteLength) override;
+        double consume(double bytes) override;
+        void end() override;
+
+    private:
+        void feed(const uint8_t *data, size_t length);
+        void drain();
+        size_t decode(const uint8_t *data, size_t length);
+        uint8_t *writeRegion(size_t &available);
+        void initialize(int windowBits);
+
+        bool _gzip;
+        std::shared_ptr<ArrayBuffer> _ring;
+        size_t _ringSize;
+        size_t _readOffset = 0;
+        size_t _readable = 0;
+
+        z_stream _zstream{};
+        bool _initialized = false;
+        // Deflate bodies: first bytes until zlib vs raw is decided
+        std::vector<uint8_t> _header;
+        // Input the ring had no room for yet
+        std::vector<uint8_t> _pending;
+        // inflate filled the ring and may still hold output
+        bool _outputStalled = false;
+        // A gzip member ended, the next byte starts another one or trailing data
+        bool _memberEnded = false;
+        bool _finished = false;
+    };
+
+} // namespace margelo::nitro::rnzlib
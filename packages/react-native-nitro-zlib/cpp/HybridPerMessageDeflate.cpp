@@ -0,0 +1,482 @@
+#include "HybridPerMessageDeflate.hpp"
+#include "InputView.hpp"
+#include "ZlibCodec.hpp"
+#include "ZlibTrace.hpp"
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+namespace margelo::nitro::rnzlib
+{
+    namespace
+    {
+        constexpr const char *EXTENSION_NAME = "permessage-deflate";
+
+        // Every message compressed with Z_SYNC_FLUSH ends in an empty stored block
+        constexpr uint8_t SYNC_TAIL[4] = {0x00, 0x00, 0xff, 0xff};
+
+        // zlib refuses a raw deflate window of 8 bits, so 9 is the smallest we can compress with
+        constexpr int MIN_WINDOW_BITS = 9;
+        constexpr int MAX_WINDOW_BITS = 15;
+
+        struct ExtensionParam
+        {
+            std::string name;
+            std::optional<std::string> value;
+        };
+
+        struct Extension
+        {
+            std::string name;
+            std::vector<ExtensionParam> params;
+        };
+
+        std::string trim(const std::string &text)
+        {
+            size_t begin = text.find_first_not_of(" \t");
+            if (begin == std::string::npos)
+                return "";
+            size_t end = text.find_last_not_of(" \t");
+            return text.substr(begin, end - begin + 1);
+        }
+
+        std::string lowercase(std::string text)
+        {
+            std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c)
+                           { return static_cast<char>(std::tolower(c)); });
+            return text;
+        }
+
+        // Splits on `separator` outside of quoted strings
+        std::vector<std::string> split(const std::string &text, char separator)
+        {
+            std::vector<std::string> parts;
+            std::string current;
+            bool quoted = false;
+            for (char c : text)
+            {
+                if (c == '"')
+                    quoted = !quoted;
+                if (c == separator && !quoted)
+                {
+                    parts.push_back(trim(current));
+                    current.clear();
+                    continue;
+                }
+                current += c;
+            }
+            parts.push_back(trim(current));
+            return parts;
+        }
+
+        // Sec-WebSocket-Extensions: name; param; param=value, name; ...
+        std::vector<Extension> parseExtensions(const std::string &header)
+        {
+            std::vector<Extension> extensions;
+            for (const auto &item : split(header, ','))
+            {
+                if (item.empty())
+                    continue;
+                auto parts = split(item, ';');
+                Extension extension{lowercase(parts[0]), {}};
+                for (size_t i = 1; i < parts.size(); i++)
+                {
+                    const auto &part = parts[i];
+                    size_t equals = part.find('=');
+                    if (equals == std::string::npos)
+                    {
+                        extension.params.push_back({lowercase(part), std::nullopt});
+                        continue;
+                    }
+                    std::string value = trim(part.substr(equals + 1));
+                    if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+                        value = value.substr(1, value.size() - 2);
+                    extension.params.push_back({lowercase(trim(part.substr(0, equals))), value});
+                }
+                extensions.push_back(std::move(extension));
+            }
+            return extensions;
+        }
+
+        // RFC 7692 window bits: 8..15, no leading zeros
+        std::optional<int> parseWindowBits(const std::string &value)
+        {
+            if (value.size() == 1 && value[0] >= '8' && value[0] <= '9')
+                return value[0] - '0';
+            if (value.size() == 2 && value[0] == '1' && value[1] >= '0' && value[1] <= '5')
+                return 10 + value[1] - '0';
+            return std::nullopt;
+        }
+
+        int windowBitsOption(const std::optional<double> &value, const char *name)
+        {
+            if (!value.has_value())
+                return 0;
+            int bits = static_cast<int>(value.value());
+            if (bits < MIN_WINDOW_BITS || bits > MAX_WINDOW_BITS)
+                throw std::runtime_error(std::string(name) + " must be between 9 and 15");
+            return bits;
+        }
+
+        std::string zlibError(const char *what, int ret, const z_stream &strm)
+        {
+            std::string message = std::string(what) + " (" + std::to_string(ret) + ")";
+            if (strm.msg != nullptr)
+                message += ": " + std::string(strm.msg);
+            return message;
+        }
+    } // namespace
+
+    HybridPerMessageDeflate::HybridPerMessageDeflate(const PerMessageDeflateOptions &options)
+        : HybridObject(TAG),
+          _isServer(options.isServer),
+          _serverNoContextTakeover(options.serverNoContextTakeover.value_or(false)),
+          _clientNoContextTakeover(options.clientNoContextTakeover.value_or(false)),
+          _serverMaxWindowBits(windowBitsOption(options.serverMaxWindowBits, "serverMaxWindowBits")),
+          _clientMaxWindowBits(windowBitsOption(options.clientMaxWindowBits, "clientMaxWindowBits")),
+          _level(static_cast<int>(options.level.value_or(Z_DEFAULT_COMPRESSION))),
+          _memLevel(static_cast<int>(options.memLevel.value_or(8))),
+          _maxMessageSize(options.maxMessageSize.has_value() ? static_cast<size_t>(options.maxMessageSize.value()) : SIZE_MAX)
+    {
+        if (_level < Z_DEFAULT_COMPRESSION || _level > Z_BEST_COMPRESSION)
+            throw std::runtime_error("level must be between -1 and 9");
+        if (_memLevel < 1 || _memLevel > MAX_MEM_LEVEL)
+            throw std::runtime_error("memLevel must be between 1 and 9");
+    }
+
+    HybridPerMessageDeflate::~HybridPerMessageDeflate()
+    {
+        releaseStreams();
+    }
+
+    std::string HybridPerMessageDeflate::offer()
+    {
+        if (_isServer)
+            throw std::runtime_error("offer() is for clients, servers answer with negotiate()");
+
+        // Always allow the server to limit our window, we compress with whatever it picks
+        std::string offer = EXTENSION_NAME;
+        offer += "; client_max_window_bits";
+        if (_clientMaxWindowBits != 0)
+            offer.append("=").append(std::to_string(_clientMaxWindowBits));
+        if (_serverMaxWindowBits != 0)
+            offer.append("; server_max_window_bits=").append(std::to_string(_serverMaxWindowBits));
+        if (_serverNoContextTakeover)
+            offer += "; server_no_context_takeover";
+        if (_clientNoContextTakeover)
+            offer += "; client_no_context_takeover";
+        return offer;
+    }
+
+    std::string HybridPerMessageDeflate::negotiate(const std::string &header)
+    {
+        if (_isServer)
+            return negotiateServer(header);
+        negotiateClient(header);
+        return _negotiated ? trim(header) : "";
+    }
+
+    std::string HybridPerMessageDeflate::negotiateServer(const std::string &header)
+    {
+        releaseStreams();
+        _negotiated = false;
+
+        // The client lists offers by preference, take the first one we can honor
+        for (const auto &extension : parseExtensions(header))
+        {
+            if (extension.name != EXTENSION_NAME)
+                continue;
+
+            Agreement agreement;
+            bool valid = true;
+            bool serverBitsOffered = false;
+            bool clientBitsOffered = false;
+            int clientBitsLimit = MAX_WINDOW_BITS;
+            std::set<std::string> seen;
+            for (const auto &param : extension.params)
+            {
+                if (!seen.insert(param.name).second)
+                    valid = false;
+                else if (param.name == "server_no_context_takeover" && !param.value.has_value())
+                    agreement.serverNoContextTakeover = true;
+                else if (param.name == "client_no_context_takeover" && !param.value.has_value())
+                    agreement.clientNoContextTakeover = true;
+                else if (param.name == "server_max_window_bits" && param.value.has_value())
+                {
+                    auto bits = parseWindowBits(param.value.value());
+                    valid = bits.has_value();
+                    agreement.serverMaxWindowBits = bits.value_or(MAX_WINDOW_BITS);
+                    serverBitsOffered = true;
+                }
+                else if (param.name == "client_max_window_bits")
+                {
+                    if (param.value.has_value())
+                    {
+                        auto bits = parseWindowBits(param.value.value());
+                        valid = bits.has_value();
+                        clientBitsLimit = bits.value_or(MAX_WINDOW_BITS);
+                    }
+                    clientBitsOffered = true;
+                }
+                else
+                    valid = false;
+                if (!valid)
+                    break;
+            }
+            if (!valid)
+                continue;
+
+            // Our own limits on top of what the client asked for
+            agreement.serverNoContextTakeover |= _serverNoContextTakeover;
+            agreement.clientNoContextTakeover |= _clientNoContextTakeover;
+            if (_serverMaxWindowBits != 0)
+                agreement.serverMaxWindowBits = std::min(agreement.serverMaxWindowBits, _serverMaxWindowBits);
+            if (agreement.serverMaxWindowBits < MIN_WINDOW_BITS)
+                continue;
+            // The client window can only be limited when the client said it supports that
+            bool clientBitsInResponse = clientBitsOffered && _clientMaxWindowBits != 0;
+            if (clientBitsInResponse)
+                agreement.clientMaxWindowBits = std::min(clientBitsLimit, _clientMaxWindowBits);
+
+            std::string response = EXTENSION_NAME;
+            if (agreement.serverNoContextTakeover)
+                response += "; server_no_context_takeover";
+            if (agreement.clientNoContextTakeover)
+                response += "; client_no_context_takeover";
+            if (serverBitsOffered || _serverMaxWindowBits != 0)
+                response.append("; server_max_window_bits=").append(std::to_string(agreement.serverMaxWindowBits));
+            if (clientBitsInResponse)
+                response.append("; client_max_window_bits=").append(std::to_string(agreement.clientMaxWindowBits));
+
+            start(agreement);
+            ZLIB_LOG_DEBUG("PerMessageDeflate", "Accepted offer: %s", response.c_str());
+            return response;
+        }
+
+        ZLIB_LOG_DEBUG("PerMessageDeflate", "No acceptable permessage-deflate offer");
+        return "";
+    }
+
+    void HybridPerMessageDeflate::negotiateClient(const std::string &header)
+    {
+        releaseStreams();
+        _negotiated = false;
+
+        const Extension *accepted = nullptr;
+        auto extensions = parseExtensions(header);
+        for (const auto &extension : extensions)
+        {
+            if (extension.name != EXTENSION_NAME)
+                continue;
+            if (accepted != nullptr)
+                throw std::runtime_error("Server accepted permessage-deflate more than once");
+            accepted = &extension;
+        }
+        // The server declined, messages go uncompressed
+        if (accepted == nullptr)
+            return;
+
+        Agreement agreement;
+        std::set<std::string> seen;
+        for (const auto &param : accepted->params)
+        {
+            if (!seen.insert(param.name).second)
+                throw std::runtime_error("Duplicate permessage-deflate parameter: " + param.name);
+
+            if (param.name == "server_no_context_takeover" && !param.value.has_value())
+            {
+                agreement.serverNoContextTakeover = true;
+                continue;
+            }
+            if (param.name == "client_no_context_takeover" && !param.value.has_value())
+            {
+                agreement.clientNoContextTakeover = true;
+                continue;
+            }
+
+            bool serverBits = param.name == "server_max_window_bits";
+            bool clientBits = param.name == "client_max_window_bits";
+            auto bits = param.value.has_value() ? parseWindowBits(param.value.value()) : std::nullopt;
+            if ((!serverBits && !clientBits) || !bits.has_value())
+                throw std::runtime_error("Invalid permessage-deflate parameter: " + param.name);
+
+            int limit = serverBits ? _serverMaxWindowBits : _clientMaxWindowBits;
+            if (limit != 0 && bits.value() > limit)
+                throw std::runtime_error("Server answered " + param.name + "=" + std::to_string(bits.value()) +
+                                         ", above the offered " + std::to_string(limit));
+            if (serverBits)
+                agreement.serverMaxWindowBits = bits.value();
+            else if (bits.value() < MIN_WINDOW_BITS)
+                throw std::runtime_error("client_max_window_bits=8 is not supported, zlib needs at least 9");
+            else
+                agreement.clientMaxWindowBits = bits.value();
+        }
+
+        // Limits on our own side need no agreement
+        agreement.clientNoContextTakeover |= _clientNoContextTakeover;
+        if (_clientMaxWindowBits != 0)
+            agreement.clientMaxWindowBits = std::min(agreement.clientMaxWindowBits, _clientMaxWindowBits);
+
+        start(agreement);
+    }
+
+    void HybridPerMessageDeflate::start(const Agreement &agreement)
+    {
+        int deflateBits = _isServer ? agreement.serverMaxWindowBits : agreement.clientMaxWindowBits;
+        int inflateBits = _isServer ? agreement.clientMaxWindowBits : agreement.serverMaxWindowBits;
+        _resetDeflate = _isServer ? agreement.serverNoContextTakeover : agreement.clientNoContextTakeover;
+        _resetInflate = _isServer ? agreement.clientNoContextTakeover : agreement.serverNoContextTakeover;
+
+        int ret = deflateInit2(&_deflate, _level, Z_DEFLATED, -deflateBits, _memLevel, Z_DEFAULT_STRATEGY);
+        if (ret != Z_OK)
+            throw std::runtime_error(zlibError("Failed to initialize permessage-deflate", ret, _deflate));
+        _deflateReady = true;
+
+        ret = inflateInit2(&_inflate, -inflateBits);
+        if (ret != Z_OK)
+        {
+            releaseStreams();
+            throw std::runtime_error(zlibError("Failed to initialize permessage-deflate", ret, _inflate));
+        }
+        _inflateReady = true;
+        _negotiated = true;
+    }
+
+    void HybridPerMessageDeflate::releaseStreams()
+    {
+        if (_deflateReady)
+            deflateEnd(&_deflate);
+        if (_inflateReady)
+            inflateEnd(&_inflate);
+        _deflate = z_stream{};
+        _inflate = z_stream{};
+        _deflateReady = _inflateReady = false;
+    }
+
+    std::shared_ptr<ArrayBuffer> HybridPerMessageDeflate::compress(const std::shared_ptr<ArrayBuffer> &message,
+                                                                   std::optional<double> byteOffset, std::optional<double> byteLength)
+    {
+        if (!_negotiated)
+            throw std::runtime_error("permessage-deflate was not negotiated");
+
+        auto view = inputView(message, byteOffset, byteLength);
+        const uint8_t *input = view.data;
+        size_t remaining = view.size;
+
+        HeapOutput output(16 * 1024);
+        output.reserve(deflateBound(&_deflate, static_cast<uLong>(std::min<size_t>(remaining, UINT_MAX))) + sizeof(SYNC_TAIL));
+
+        // One sync flush at the end of the message, input over 4 GB is fed in slices
+        do
+        {
+            uInt slice = static_cast<uInt>(std::min<size_t>(remaining, UINT_MAX));
+            _deflate.next_in = const_cast<Bytef *>(input);
+            _deflate.avail_in = slice;
+            int flush = slice == remaining ? Z_SYNC_FLUSH : Z_NO_FLUSH;
+            do
+            {
+                size_t available = 0;
+                _deflate.next_out = output.prepare(available, UINT_MAX);
+                _deflate.avail_out = static_cast<uInt>(available);
+                int ret = ::deflate(&_deflate, flush);
+                output.commit(available - _deflate.avail_out);
+                if (ret == Z_STREAM_ERROR)
+                    throw std::runtime_error(zlibError("permessage-deflate compression failed", ret, _deflate));
+            } while (_deflate.avail_out == 0 || _deflate.avail_in > 0);
+            input += slice;
+            remaining -= slice;
+        } while (remaining > 0);
+
+        // The empty stored block is implied by the protocol, peers append it back.
+        // zlib emits nothing for an empty message right after a flush, which is
+        // sent as a single 00 byte (RFC 7692 7.2.3.6).
+        if (output.size() >= sizeof(SYNC_TAIL))
+        {
+            output.drop(sizeof(SYNC_TAIL));
+        }
+        else
+        {
+            size_t available = 0;
+            *output.prepare(available, 1) = 0x00;
+            output.commit(1);
+        }
+
+        if (_resetDeflate)
+            deflateReset(&_deflate);
+        return output.release();
+    }
+
+    std::shared_ptr<ArrayBuffer> HybridPerMessageDeflate::decompress(const std::shared_ptr<ArrayBuffer> &payload,
+                                                                     std::optional<double> byteOffset, std::optional<double> byteLength)
+    {
+        if (!_negotiated)
+            throw std::runtime_error("permessage-deflate was not negotiated");
+
+        auto input = inputView(payload, byteOffset, byteLength);
+        HeapOutput output(16 * 1024);
+        output.reserve(std::min<size_t>(input.size * 4 + 64, _maxMessageSize));
+
+        // One byte past the limit tells a full message apart from an oversized one
+        size_t limit = _maxMessageSize == SIZE_MAX ? SIZE_MAX : _maxMessageSize + 1;
+        bool streamEnd = false;
+
+        auto feed = [&](const uint8_t *data, size_t length)
+        {
+            while (length > 0 && !streamEnd)
+            {
+                uInt slice = static_cast<uInt>(std::min<size_t>(length, UINT_MAX));
+                _inflate.next_in = const_cast<Bytef *>(data);
+                _inflate.avail_in = slice;
+                while (true)
+                {
+                    size_t available = 0;
+                    _inflate.next_out = output.prepare(available, std::min<size_t>(limit - output.size(), UINT_MAX));
+                    _inflate.avail_out = static_cast<uInt>(available);
+                    int ret = ::inflate(&_inflate, Z_SYNC_FLUSH);
+                    output.commit(available - _inflate.avail_out);
+
+                    if (output.size() > _maxMessageSize)
+                    {
+                        inflateReset(&_inflate);
+                        throw std::runtime_error("Message exceeds maxMessageSize");
+                    }
+                    if (ret == Z_STREAM_END)
+                    {
+                        streamEnd = true;
+                        break;
+                    }
+                    if (ret == Z_BUF_ERROR || (ret == Z_OK && _inflate.avail_in == 0 && _inflate.avail_out > 0))
+                        break;
+                    if (ret != Z_OK)
+                    {
+                        std::string message = zlibError("permessage-deflate decompression failed", ret, _inflate);
+                        inflateReset(&_inflate);
+                        throw std::runtime_error(message);
+                    }
+                }
+                data += slice;
+                length -= slice;
+            }
+        };
+
+        feed(input.data, input.size);
+        feed(SYNC_TAIL, sizeof(SYNC_TAIL));
+
+        // A final block ends the peer's deflate stream, its next message starts a fresh one
+        if (streamEnd || _resetInflate)
+            inflateReset(&_inflate);
+        return output.release();
+    }
+
+    void HybridPerMessageDeflate::reset()
+    {
+        if (_deflateReady)
+            deflateReset(&_deflate);
+        if (_inflateReady)
+            inflateReset(&_inflate);
+    }
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,71 @@
+// HybridPerMessageDeflate.hpp
+
+#pragma once
+
+#include "HybridPerMessageDeflateSpec.hpp"
+#include "PerMessageDeflateOptions.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+#include <zlib.h>
+#include <memory>
+#include <string>
+
+namespace margelo::nitro::rnzlib
+{
+
+    /**
+     * WebSocket permessage-deflate (RFC 7692). One object per connection keeps
+     * a raw deflate and a raw inflate z_stream across messages (context
+     * takeover) unless negotiation turned that off for a direction. Each call
+     * handles one whole message: compress() drops the trailing 00 00 ff ff of
+     * the sync flush, decompress() feeds it back in after the payload.
+     */
+    class HybridPerMessageDeflate : public HybridPerMessageDeflateSpec
+    {
+    public:
+        explicit HybridPerMessageDeflate(const PerMessageDeflateOptions &options);
+        ~HybridPerMessageDeflate() override;
+
+        std::string offer() override;
+        std::string negotiate(const std::string &header) override;
+        std::shared_ptr<ArrayBuffer> compress(const std::shared_ptr<ArrayBuffer> &message,
+                                              std::optional<double> byteOffset, std::optional<double> byteLength) override;
+        std::shared_ptr<ArrayBuffer> decompress(const std::shared_ptr<ArrayBuffer> &payload,
+                                                std::optional<double> byteOffset, std::optional<double> byteLength) override;
+        void reset() override;
+
+    private:
+        // Negotiated parameters, per direction
+        struct Agreement
+        {
+            bool serverNoContextTakeover = false;
+            bool clientNoContextTakeover = false;
+            int serverMaxWindowBits = 15;
+            int clientMaxWindowBits = 15;
+        };
+
+        std::string negotiateServer(const std::string &header);
+        void negotiateClient(const std::string &header);
+        void start(const Agreement &agreement);
+        void releaseStreams();
+
+        bool _isServer;
+        bool _serverNoContextTakeover;
+        bool _clientNoContextTakeover;
+        // 0 = no limit requested
+        int _serverMaxWindowBits;
+        int _clientMaxWindowBits;
+        int _level;
+        int _memLevel;
+        size_t _maxMessageSize;
+
+        bool _negotiated = false;
+        // Reset our deflater / the peer's inflater after every message
+        bool _resetDeflate = false;
+        bool _resetInflate = false;
+        z_stream _deflate{};
+        z_stream _inflate{};
+        bool _deflateReady = false;
+        bool _inflateReady = false;
+    };
+
+} // namespace margelo::nitro::rnzlib
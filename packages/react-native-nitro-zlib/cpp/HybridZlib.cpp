@@ -1,9 +1,11 @@
 #include "HybridZlib.hpp"
-#include <NitroModules/NitroLogger.hpp>
+#include "ZlibTrace.hpp"
 #include <stdexcept>
 #include <vector>
 #include "HybridZlibStream.hpp"
-#include "ZlibProcessor.hpp"
+#include "HybridPerMessageDeflate.hpp"
+#include "HybridContentDecoder.hpp"
+#include "HybridCompressedStore.hpp"
 
 namespace margelo::nitro::rnzlib
 {
@@ -12,363 +14,426 @@ namespace margelo::nitro::rnzlib
         return zlibVersion();
     }
 
-    struct SafeBufferData
+    // Sync Methods
+    std::shared_ptr<ArrayBuffer> HybridZlib::inflateSync(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
     {
-        std::vector<uint8_t> data;
+        return processZlib<Direction::Inflate, Format::Zlib>(MetricOp::inflateSync, data, options);
+    }
 
-        static SafeBufferData copyFromBuffer(const std::shared_ptr<ArrayBuffer> &buffer)
-        {
-            SafeBufferData result;
-            // This runs on JS thread
-            size_t size = buffer->size();
-            const uint8_t *ptr = static_cast<const uint8_t *>(buffer->data());
-            result.data.assign(ptr, ptr + size);
-            return result;
-        }
-    };
+    std::shared_ptr<ArrayBuffer> HybridZlib::inflateRawSync(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    {
+        return processZlib<Direction::Inflate, Format::Raw>(MetricOp::inflateRawSync, data, options);
+    }
+
+    std::shared_ptr<ArrayBuffer> HybridZlib::compressSync(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    {
+        return processZlib<Direction::Deflate, Format::Zlib>(MetricOp::compressSync, data, options);
+    }
+
+    std::shared_ptr<ArrayBuffer> HybridZlib::deflateSync(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    {
+        return processZlib<Direction::Deflate, Format::Zlib>(MetricOp::deflateSync, data, options);
+    }
+
+    std::shared_ptr<ArrayBuffer> HybridZlib::deflateRawSync(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    {
+        return processZlib<Direction::Deflate, Format::Raw>(MetricOp::deflateRawSync, data, options);
+    }
+
+    std::shared_ptr<ArrayBuffer> HybridZlib::gzipSync(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    {
+        return processZlib<Direction::Deflate, Format::Gzip>(MetricOp::gzipSync, data, options);
+    }
+
+    std::shared_ptr<ArrayBuffer> HybridZlib::gunzipSync(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    {
+        return processZlib<Direction::Inflate, Format::Gzip>(MetricOp::gunzipSync, data, options);
+    }
 
-    std::shared_ptr<ArrayBuffer> HybridZlib::processZlib(
+    // Async Methods
+    std::future<std::shared_ptr<ArrayBuffer>> HybridZlib::inflate(
         const std::shared_ptr<ArrayBuffer> &data,
-        int (*zlibFunc)(z_stream *, int),
-        std::function<int(z_stream *, int)> zlibInit,
-        int windowBits,
         const std::optional<ZlibOptions> &options)
     {
-        Logger::log(LogLevel::Debug, "HybridZlib", "processZlib started: input size = %zu bytes", data->size());
+        return processZlibAsync<Direction::Inflate, Format::Zlib>(MetricOp::inflate, data, options);
+    }
 
-        z_stream strm;
-        strm.zalloc = Z_NULL;
-        strm.zfree = Z_NULL;
-        strm.opaque = Z_NULL;
-        strm.avail_in = data->size();
-        strm.next_in = const_cast<Bytef *>(static_cast<const Bytef *>(data->data()));
+    std::future<std::shared_ptr<ArrayBuffer>> HybridZlib::inflateRaw(
+        const std::shared_ptr<ArrayBuffer> &data,
+        const std::optional<ZlibOptions> &options)
+    {
+        return processZlibAsync<Direction::Inflate, Format::Raw>(MetricOp::inflateRaw, data, options);
+    }
 
-        // Initialize with custom window bits if provided
-        int actualWindowBits = getWindowBits(options, windowBits);
-        int ret = zlibInit(&strm, actualWindowBits);
-        if (ret != Z_OK)
-        {
-            Logger::log(LogLevel::Error, "HybridZlib", "Failed to initialize zlib function: ret = %d", ret);
-            throw std::runtime_error("Failed to initialize zlib function");
-        }
+    std::future<std::shared_ptr<ArrayBuffer>> HybridZlib::compress(
+        const std::shared_ptr<ArrayBuffer> &data,
+        const std::optional<ZlibOptions> &options)
+    {
+        return processZlibAsync<Direction::Deflate, Format::Zlib>(MetricOp::compress, data, options);
+    }
+
+    std::future<std::shared_ptr<ArrayBuffer>> HybridZlib::deflate(
+        const std::shared_ptr<ArrayBuffer> &data,
+        const std::optional<ZlibOptions> &options)
+    {
+        return processZlibAsync<Direction::Deflate, Format::Zlib>(MetricOp::deflate, data, options);
+    }
 
-        // Get chunk size from options or use default
-        const size_t CHUNK = getChunkSize(options);
-        std::vector<unsigned char> buffer;
-        int iterations = 0;
-        const int MAX_ITERATIONS = 1000;
+    std::future<std::shared_ptr<ArrayBuffer>> HybridZlib::deflateRaw(
+        const std::shared_ptr<ArrayBuffer> &data,
+        const std::optional<ZlibOptions> &options)
+    {
+        return processZlibAsync<Direction::Deflate, Format::Raw>(MetricOp::deflateRaw, data, options);
+    }
 
-        // Get maxOutputLength if specified
-        size_t maxOutputLength = options.has_value() && options->maxOutputLength.has_value()
-                                     ? static_cast<size_t>(options->maxOutputLength.value())
-                                     : SIZE_MAX;
+    std::future<std::shared_ptr<ArrayBuffer>> HybridZlib::gzip(
+        const std::shared_ptr<ArrayBuffer> &data,
+        const std::optional<ZlibOptions> &options)
+    {
+        return processZlibAsync<Direction::Deflate, Format::Gzip>(MetricOp::gzip, data, options);
+    }
 
-        do
-        {
-            if (buffer.size() >= maxOutputLength)
-            {
-                deflateEnd(&strm);
-                Logger::log(LogLevel::Error, "HybridZlib", "Output exceeds maxOutputLength");
-                throw std::runtime_error("Output exceeds maxOutputLength");
-            }
-
-            buffer.resize(std::min(buffer.size() + CHUNK, maxOutputLength));
-            strm.avail_out = CHUNK;
-            strm.next_out = buffer.data() + buffer.size() - CHUNK;
-
-            // Get flush mode from options or use default
-            int flushMode = Z_FINISH;
-            if (options.has_value() && options->flush.has_value())
-            {
-                flushMode = static_cast<int>(options->flush.value());
-            }
-
-            ret = zlibFunc(&strm, flushMode);
-            Logger::log(LogLevel::Debug, "HybridZlib", "Zlib iteration %d: avail_in = %u, avail_out = %u, ret = %d",
-                        iterations, strm.avail_in, strm.avail_out, ret);
-
-            if (ret == Z_BUF_ERROR)
-            {
-                if (buffer.size() >= maxOutputLength)
-                {
-                    deflateEnd(&strm);
-                    throw std::runtime_error("Buffer error: Output would exceed maxOutputLength");
-                }
-                continue;
-            }
-
-            if (ret == Z_STREAM_ERROR)
-            {
-                deflateEnd(&strm);
-                Logger::log(LogLevel::Error, "HybridZlib", "Z_STREAM_ERROR in zlib function");
-                throw std::runtime_error("Z_STREAM_ERROR in zlib function");
-            }
-
-            iterations++;
-            if (iterations > MAX_ITERATIONS)
-            {
-                deflateEnd(&strm);
-                Logger::log(LogLevel::Error, "HybridZlib", "Maximum iteration count exceeded");
-                throw std::runtime_error("Maximum iteration count exceeded");
-            }
-        } while (ret != Z_STREAM_END);
-
-        buffer.resize(buffer.size() - strm.avail_out);
-        deflateEnd(&strm);
-
-        Logger::log(LogLevel::Debug, "HybridZlib", "processZlib completed: output size = %zu bytes", buffer.size());
-
-        uint8_t *bufferData = new uint8_t[buffer.size()];
-        std::memcpy(bufferData, buffer.data(), buffer.size());
-        return std::make_shared<NativeArrayBuffer>(bufferData, buffer.size(), [=]()
-                                                   { delete[] bufferData; });
+    std::future<std::shared_ptr<ArrayBuffer>> HybridZlib::gunzip(
+        const std::shared_ptr<ArrayBuffer> &data,
+        const std::optional<ZlibOptions> &options)
+    {
+        return processZlibAsync<Direction::Inflate, Format::Gzip>(MetricOp::gunzip, data, options);
     }
 
-    // Sync Methods
-    std::shared_ptr<ArrayBuffer> HybridZlib::inflateSync(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    // Unzip Methods
+    std::shared_ptr<ArrayBuffer> HybridZlib::unzipSync(
+        const std::shared_ptr<ArrayBuffer> &data,
+        const std::optional<ZlibOptions> &options)
     {
-        return processZlib(data, ::inflate, [options](z_streamp strm, int windowBits)
-                           { return inflateInit2(strm, windowBits); }, 15, options);
+        auto input = inputView(data, options);
+        MetricsScope metrics(MetricOp::unzipSync, input.size);
+        auto result = runUnzip(input.data, input.size, CodecParams::from(options));
+        metrics.setBytesOut(result->size());
+        return result;
     }
 
-    std::shared_ptr<ArrayBuffer> HybridZlib::inflateRawSync(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    std::future<std::shared_ptr<ArrayBuffer>> HybridZlib::unzip(
+        const std::shared_ptr<ArrayBuffer> &data,
+        const std::optional<ZlibOptions> &options)
     {
-        return processZlib(data, ::inflate, [options](z_streamp strm, int windowBits)
-                           { return inflateInit2(strm, -windowBits); }, 15, options);
+        auto processor = std::make_shared<ZlibProcessor>(inputView(data, options));
+        return submitCodecJob(CodecParams::from(options), [processor](const CodecParams &params)
+                              {
+                                  MetricsScope metrics(MetricOp::unzip, processor->size());
+                                  auto result = processor->unzip(params);
+                                  metrics.setBytesOut(result->size());
+                                  return result; });
     }
 
-    std::shared_ptr<ArrayBuffer> HybridZlib::compressSync(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    // Into Methods
+    double HybridZlib::inflateInto(const std::shared_ptr<ArrayBuffer> &data, const std::shared_ptr<ArrayBuffer> &dst, std::optional<double> dstOffset, const std::optional<ZlibOptions> &options)
     {
-        int compressionLevel = getCompressionLevel(options);
-        return processZlib(data, ::deflate, [compressionLevel](z_streamp strm, int windowBits)
-                           { return deflateInit(strm, compressionLevel); }, 15, options);
+        return processZlibInto<Direction::Inflate, Format::Zlib>(MetricOp::inflateInto, data, dst, dstOffset, options);
     }
 
-    std::shared_ptr<ArrayBuffer> HybridZlib::deflateSync(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    double HybridZlib::gunzipInto(const std::shared_ptr<ArrayBuffer> &data, const std::shared_ptr<ArrayBuffer> &dst, std::optional<double> dstOffset, const std::optional<ZlibOptions> &options)
     {
-        int compressionLevel = getCompressionLevel(options);
-        int memLevel = getMemLevel(options);
-        int strategy = getStrategy(options);
+        return processZlibInto<Direction::Inflate, Format::Gzip>(MetricOp::gunzipInto, data, dst, dstOffset, options);
+    }
 
-        return processZlib(data, ::deflate, [compressionLevel, memLevel, strategy](z_streamp strm, int windowBits)
-                           { return deflateInit2(strm, compressionLevel, Z_DEFLATED, windowBits, memLevel, strategy); }, 15, options);
+    double HybridZlib::deflateInto(const std::shared_ptr<ArrayBuffer> &data, const std::shared_ptr<ArrayBuffer> &dst, std::optional<double> dstOffset, const std::optional<ZlibOptions> &options)
+    {
+        return processZlibInto<Direction::Deflate, Format::Zlib>(MetricOp::deflateInto, data, dst, dstOffset, options);
     }
 
-    std::shared_ptr<ArrayBuffer> HybridZlib::deflateRawSync(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    // String Methods
+    std::shared_ptr<ArrayBuffer> HybridZlib::deflateString(const std::string &text, const std::optional<ZlibOptions> &options)
     {
-        int compressionLevel = getCompressionLevel(options);
-        int memLevel = getMemLevel(options);
-        int strategy = getStrategy(options);
+        return processString<Direction::Deflate, Format::Zlib>(MetricOp::deflateString, text, options);
+    }
 
-        return processZlib(data, ::deflate, [compressionLevel, memLevel, strategy](z_streamp strm, int windowBits)
-                           { return deflateInit2(strm, compressionLevel, Z_DEFLATED, -windowBits, memLevel, strategy); }, 15, options);
+    std::shared_ptr<ArrayBuffer> HybridZlib::gzipString(const std::string &text, const std::optional<ZlibOptions> &options)
+    {
+        return processString<Direction::Deflate, Format::Gzip>(MetricOp::gzipString, text, options);
     }
 
-    std::shared_ptr<ArrayBuffer> HybridZlib::gzipSync(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    std::string HybridZlib::inflateToString(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
     {
-        int compressionLevel = getCompressionLevel(options);
-        int memLevel = getMemLevel(options);
-        int strategy = getStrategy(options);
+        return processToString<Direction::Inflate, Format::Zlib>(MetricOp::inflateToString, data, options);
+    }
 
-        return processZlib(data, ::deflate, [compressionLevel, memLevel, strategy](z_streamp strm, int windowBits)
-                           { return deflateInit2(strm, compressionLevel, Z_DEFLATED, windowBits | 16, memLevel, strategy); }, 15, options);
+    std::string HybridZlib::gunzipToString(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    {
+        return processToString<Direction::Inflate, Format::Gzip>(MetricOp::gunzipToString, data, options);
     }
 
-    std::shared_ptr<ArrayBuffer> HybridZlib::gunzipSync(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    // Base64 Methods
+    std::string HybridZlib::deflateToBase64(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
     {
-        return processZlib(data, ::inflate, [](z_streamp strm, int windowBits)
-                           { return inflateInit2(strm, windowBits | 16); }, 15, options);
+        return processToBase64<Direction::Deflate, Format::Zlib>(MetricOp::deflateToBase64, data, options);
     }
 
-    // Async Methods
-    std::future<std::shared_ptr<ArrayBuffer>> HybridZlib::inflate(
+    std::string HybridZlib::gzipToBase64(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    {
+        return processToBase64<Direction::Deflate, Format::Gzip>(MetricOp::gzipToBase64, data, options);
+    }
+
+    std::shared_ptr<ArrayBuffer> HybridZlib::inflateFromBase64(const std::string &base64, const std::optional<ZlibOptions> &options)
+    {
+        return processFromBase64<Direction::Inflate, Format::Zlib>(MetricOp::inflateFromBase64, base64, options);
+    }
+
+    std::shared_ptr<ArrayBuffer> HybridZlib::gunzipFromBase64(const std::string &base64, const std::optional<ZlibOptions> &options)
+    {
+        return processFromBase64<Direction::Inflate, Format::Gzip>(MetricOp::gunzipFromBase64, base64, options);
+    }
+
+    // Handle Methods
+    std::shared_ptr<HybridCompressedBufferSpec> HybridZlib::deflateToHandle(const ZlibInput &data, const std::optional<ZlibOptions> &options)
+    {
+        return processToHandle<Direction::Deflate, Format::Zlib>(MetricOp::deflateToHandle, data, options);
+    }
+
+    std::shared_ptr<HybridCompressedBufferSpec> HybridZlib::gzipToHandle(const ZlibInput &data, const std::optional<ZlibOptions> &options)
+    {
+        return processToHandle<Direction::Deflate, Format::Gzip>(MetricOp::gzipToHandle, data, options);
+    }
+
+    std::shared_ptr<HybridCompressedBufferSpec> HybridZlib::inflateToHandle(const ZlibInput &data, const std::optional<ZlibOptions> &options)
+    {
+        return processToHandle<Direction::Inflate, Format::Zlib>(MetricOp::inflateToHandle, data, options);
+    }
+
+    std::shared_ptr<HybridCompressedBufferSpec> HybridZlib::gunzipToHandle(const ZlibInput &data, const std::optional<ZlibOptions> &options)
+    {
+        return processToHandle<Direction::Inflate, Format::Gzip>(MetricOp::gunzipToHandle, data, options);
+    }
+
+    std::shared_ptr<HybridCompressedBufferSpec> HybridZlib::unzipToHandle(const ZlibInput &data, const std::optional<ZlibOptions> &options)
+    {
+        auto input = inputView(HybridCompressedBuffer::bytesOf(data), options);
+        MetricsScope metrics(MetricOp::unzipToHandle, input.size);
+        auto result = runUnzip(input.data, input.size, CodecParams::from(options));
+        metrics.setBytesOut(result->size());
+        return std::make_shared<HybridCompressedBuffer>(result);
+    }
+
+    // Segmented Methods
+    std::future<std::vector<std::shared_ptr<ArrayBuffer>>> HybridZlib::inflateSegmented(const std::shared_ptr<ArrayBuffer> &data, std::optional<double> segmentSize, const std::optional<ZlibOptions> &options)
+    {
+        return processSegmentedAsync<Direction::Inflate, Format::Zlib>(MetricOp::inflateSegmented, data, segmentSize, options);
+    }
+
+    std::future<std::vector<std::shared_ptr<ArrayBuffer>>> HybridZlib::gunzipSegmented(const std::shared_ptr<ArrayBuffer> &data, std::optional<double> segmentSize, const std::optional<ZlibOptions> &options)
+    {
+        return processSegmentedAsync<Direction::Inflate, Format::Gzip>(MetricOp::gunzipSegmented, data, segmentSize, options);
+    }
+
+    std::future<std::vector<std::shared_ptr<ArrayBuffer>>> HybridZlib::unzipSegmented(const std::shared_ptr<ArrayBuffer> &data, std::optional<double> segmentSize, const std::optional<ZlibOptions> &options)
+    {
+        size_t size = SegmentedOutput::segmentSize(segmentSize);
+        auto processor = std::make_shared<ZlibProcessor>(inputView(data, options));
+        return submitCodecJob(CodecParams::from(options), [processor, size](const CodecParams &params)
+                              {
+                                  MetricsScope metrics(MetricOp::unzipSegmented, processor->size());
+                                  auto segments = processor->unzipSegmented(params, size);
+                                  metrics.setBytesOut(totalSize(segments));
+                                  return segments; });
+    }
+
+    // WithInfo Methods
+    ZlibResult HybridZlib::inflateSyncWithInfo(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    {
+        return processZlibWithInfo<Direction::Inflate, Format::Zlib>(MetricOp::inflateSync, data, options);
+    }
+
+    ZlibResult HybridZlib::inflateRawSyncWithInfo(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    {
+        return processZlibWithInfo<Direction::Inflate, Format::Raw>(MetricOp::inflateRawSync, data, options);
+    }
+
+    ZlibResult HybridZlib::compressSyncWithInfo(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    {
+        return processZlibWithInfo<Direction::Deflate, Format::Zlib>(MetricOp::compressSync, data, options);
+    }
+
+    ZlibResult HybridZlib::deflateSyncWithInfo(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    {
+        return processZlibWithInfo<Direction::Deflate, Format::Zlib>(MetricOp::deflateSync, data, options);
+    }
+
+    ZlibResult HybridZlib::deflateRawSyncWithInfo(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    {
+        return processZlibWithInfo<Direction::Deflate, Format::Raw>(MetricOp::deflateRawSync, data, options);
+    }
+
+    ZlibResult HybridZlib::gzipSyncWithInfo(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    {
+        return processZlibWithInfo<Direction::Deflate, Format::Gzip>(MetricOp::gzipSync, data, options);
+    }
+
+    ZlibResult HybridZlib::gunzipSyncWithInfo(const std::shared_ptr<ArrayBuffer> &data, const std::optional<ZlibOptions> &options)
+    {
+        return processZlibWithInfo<Direction::Inflate, Format::Gzip>(MetricOp::gunzipSync, data, options);
+    }
+
+    std::future<ZlibResult> HybridZlib::inflateWithInfo(
         const std::shared_ptr<ArrayBuffer> &data,
         const std::optional<ZlibOptions> &options)
     {
-        auto processor = std::make_shared<ZlibProcessor>(data);
-        return std::async(std::launch::async, [processor, options]()
-                          { return processor->process(
-                                ::inflate,
-                                [](z_streamp strm, int windowBits)
-                                {
-                                    return inflateInit2(strm, windowBits);
-                                },
-                                15,
-                                options); });
+        return processZlibWithInfoAsync<Direction::Inflate, Format::Zlib>(MetricOp::inflate, data, options);
     }
 
-    std::future<std::shared_ptr<ArrayBuffer>> HybridZlib::inflateRaw(
+    std::future<ZlibResult> HybridZlib::inflateRawWithInfo(
         const std::shared_ptr<ArrayBuffer> &data,
         const std::optional<ZlibOptions> &options)
     {
-        auto processor = std::make_shared<ZlibProcessor>(data);
-        return std::async(std::launch::async, [processor, options]()
-                          { return processor->process(
-                                ::inflate,
-                                [](z_streamp strm, int windowBits)
-                                {
-                                    return inflateInit2(strm, -windowBits);
-                                },
-                                15,
-                                options); });
+        return processZlibWithInfoAsync<Direction::Inflate, Format::Raw>(MetricOp::inflateRaw, data, options);
     }
 
-    std::future<std::shared_ptr<ArrayBuffer>> HybridZlib::compress(
+    std::future<ZlibResult> HybridZlib::compressWithInfo(
         const std::shared_ptr<ArrayBuffer> &data,
         const std::optional<ZlibOptions> &options)
     {
-        auto processor = std::make_shared<ZlibProcessor>(data);
-        int compressionLevel = getCompressionLevel(options);
-
-        return std::async(std::launch::async, [processor, compressionLevel, options]()
-                          { return processor->process(
-                                ::deflate,
-                                [compressionLevel](z_streamp strm, int windowBits)
-                                {
-                                    return deflateInit(strm, compressionLevel);
-                                },
-                                15,
-                                options); });
+        return processZlibWithInfoAsync<Direction::Deflate, Format::Zlib>(MetricOp::compress, data, options);
     }
 
-    std::future<std::shared_ptr<ArrayBuffer>> HybridZlib::deflate(
+    std::future<ZlibResult> HybridZlib::deflateWithInfo(
         const std::shared_ptr<ArrayBuffer> &data,
         const std::optional<ZlibOptions> &options)
     {
-        auto processor = std::make_shared<ZlibProcessor>(data);
-        int compressionLevel = getCompressionLevel(options);
-        int memLevel = getMemLevel(options);
-        int strategy = getStrategy(options);
-
-        return std::async(std::launch::async, [processor, compressionLevel, memLevel, strategy, options]()
-                          { return processor->process(
-                                ::deflate,
-                                [compressionLevel, memLevel, strategy](z_streamp strm, int windowBits)
-                                {
-                                    return deflateInit2(strm, compressionLevel, Z_DEFLATED, windowBits,
-                                                        memLevel, strategy);
-                                },
-                                15,
-                                options); });
+        return processZlibWithInfoAsync<Direction::Deflate, Format::Zlib>(MetricOp::deflate, data, options);
     }
 
-    std::future<std::shared_ptr<ArrayBuffer>> HybridZlib::deflateRaw(
+    std::future<ZlibResult> HybridZlib::deflateRawWithInfo(
         const std::shared_ptr<ArrayBuffer> &data,
         const std::optional<ZlibOptions> &options)
     {
-        auto processor = std::make_shared<ZlibProcessor>(data);
-        int compressionLevel = getCompressionLevel(options);
-        int memLevel = getMemLevel(options);
-        int strategy = getStrategy(options);
-
-        return std::async(std::launch::async, [processor, compressionLevel, memLevel, strategy, options]()
-                          { return processor->process(
-                                ::deflate,
-                                [compressionLevel, memLevel, strategy](z_streamp strm, int windowBits)
-                                {
-                                    return deflateInit2(strm, compressionLevel, Z_DEFLATED, -windowBits,
-                                                        memLevel, strategy);
-                                },
-                                15,
-                                options); });
+        return processZlibWithInfoAsync<Direction::Deflate, Format::Raw>(MetricOp::deflateRaw, data, options);
     }
 
-    std::future<std::shared_ptr<ArrayBuffer>> HybridZlib::gzip(
+    std::future<ZlibResult> HybridZlib::gzipWithInfo(
         const std::shared_ptr<ArrayBuffer> &data,
         const std::optional<ZlibOptions> &options)
     {
-        auto processor = std::make_shared<ZlibProcessor>(data);
-        int compressionLevel = getCompressionLevel(options);
-        int memLevel = getMemLevel(options);
-        int strategy = getStrategy(options);
+        return processZlibWithInfoAsync<Direction::Deflate, Format::Gzip>(MetricOp::gzip, data, options);
+    }
 
-        return std::async(std::launch::async, [processor, compressionLevel, memLevel, strategy, options]()
-                          { return processor->process(
-                                ::deflate,
-                                [compressionLevel, memLevel, strategy](z_streamp strm, int windowBits)
-                                {
-                                    return deflateInit2(strm, compressionLevel, Z_DEFLATED, windowBits | 16,
-                                                        memLevel, strategy);
-                                },
-                                15,
-                                options); });
+    std::future<ZlibResult> HybridZlib::gunzipWithInfo(
+        const std::shared_ptr<ArrayBuffer> &data,
+        const std::optional<ZlibOptions> &options)
+    {
+        return processZlibWithInfoAsync<Direction::Inflate, Format::Gzip>(MetricOp::gunzip, data, options);
     }
 
-    std::future<std::shared_ptr<ArrayBuffer>> HybridZlib::gunzip(
+    std::future<std::shared_ptr<ArrayBuffer>> HybridZlib::gunzipParallel(
         const std::shared_ptr<ArrayBuffer> &data,
         const std::optional<ZlibOptions> &options)
     {
-        auto processor = std::make_shared<ZlibProcessor>(data);
-        return std::async(std::launch::async, [processor, options]()
-                          { return processor->process(
-                                ::inflate,
-                                [](z_streamp strm, int windowBits)
-                                {
-                                    return inflateInit2(strm, windowBits | 16);
-                                },
-                                15,
-                                options); });
+        auto processor = std::make_shared<ZlibProcessor>(inputView(data, options));
+        return submitCodecJob(CodecParams::from(options), [processor](const CodecParams &params)
+                              {
+                                  MetricsScope metrics(MetricOp::gunzipParallel, processor->size());
+                                  auto result = processor->gunzipParallel(params);
+                                  metrics.setBytesOut(result->size());
+                                  return result; });
     }
 
     // Streams
     std::shared_ptr<HybridZlibStreamSpec> HybridZlib::createDeflateStream(const std::optional<ZlibOptions> &options)
     {
-        int compressionLevel = getCompressionLevel(options);
-        int strategy = getStrategy(options);
-
-        Logger::log(LogLevel::Debug, "HybridZlib", "Creating deflate stream: level = %d, strategy = %d",
-                    compressionLevel, strategy);
-
-        auto stream = HybridZlibStream::create(compressionLevel, true);
-        stream->params(compressionLevel, strategy);
-        return stream;
+        ZLIB_LOG_DEBUG("HybridZlib", "Creating deflate stream");
+        return HybridZlibStream::create(Direction::Deflate, Format::Zlib, options);
     }
 
     std::shared_ptr<HybridZlibStreamSpec> HybridZlib::createInflateStream(const std::optional<ZlibOptions> &options)
     {
-        Logger::log(LogLevel::Debug, "HybridZlib", "Creating inflate stream");
-        return HybridZlibStream::create(Z_DEFAULT_COMPRESSION, false);
+        ZLIB_LOG_DEBUG("HybridZlib", "Creating inflate stream");
+        return HybridZlibStream::create(Direction::Inflate, Format::Zlib, options);
     }
 
     std::shared_ptr<HybridZlibStreamSpec> HybridZlib::createGzipStream(const std::optional<ZlibOptions> &options)
     {
-        int compressionLevel = getCompressionLevel(options);
-        Logger::log(LogLevel::Debug, "HybridZlib", "Creating gzip stream: level = %d", compressionLevel);
-
-        auto stream = HybridZlibStream::create(compressionLevel, true);
-        stream->params(compressionLevel, Z_DEFAULT_STRATEGY);
-        return stream;
+        ZLIB_LOG_DEBUG("HybridZlib", "Creating gzip stream");
+        return HybridZlibStream::create(Direction::Deflate, Format::Gzip, options);
     }
 
     std::shared_ptr<HybridZlibStreamSpec> HybridZlib::createGunzipStream(const std::optional<ZlibOptions> &options)
     {
-        Logger::log(LogLevel::Debug, "HybridZlib", "Creating gunzip stream");
-        return HybridZlibStream::create(Z_DEFAULT_COMPRESSION, false);
+        ZLIB_LOG_DEBUG("HybridZlib", "Creating gunzip stream");
+        return HybridZlibStream::create(Direction::Inflate, Format::Gzip, options);
     }
 
     std::shared_ptr<HybridZlibStreamSpec> HybridZlib::createDeflateRawStream(const std::optional<ZlibOptions> &options)
     {
-        int compressionLevel = getCompressionLevel(options);
-        int strategy = getStrategy(options);
-
-        Logger::log(LogLevel::Debug, "HybridZlib", "Creating raw deflate stream: level = %d, strategy = %d",
-                    compressionLevel, strategy);
-
-        auto stream = HybridZlibStream::create(compressionLevel, true);
-        stream->params(compressionLevel, strategy);
-        return stream;
+        ZLIB_LOG_DEBUG("HybridZlib", "Creating raw deflate stream");
+        return HybridZlibStream::create(Direction::Deflate, Format::Raw, options);
     }
 
     std::shared_ptr<HybridZlibStreamSpec> HybridZlib::createInflateRawStream(const std::optional<ZlibOptions> &options)
     {
-        Logger::log(LogLevel::Debug, "HybridZlib", "Creating raw inflate stream");
-        return HybridZlibStream::create(Z_DEFAULT_COMPRESSION, false);
+        ZLIB_LOG_DEBUG("HybridZlib", "Creating raw inflate stream");
+        return HybridZlibStream::create(Direction::Inflate, Format::Raw, options);
     }
 
     std::shared_ptr<HybridZlibStreamSpec> HybridZlib::createUnzipStream(const std::optional<ZlibOptions> &options)
     {
-        Logger::log(LogLevel::Debug, "HybridZlib", "Creating unzip stream");
-        return HybridZlibStream::create(Z_DEFAULT_COMPRESSION, false);
+        ZLIB_LOG_DEBUG("HybridZlib", "Creating unzip stream");
+        return HybridZlibStream::createUnzip(options);
+    }
+
+    std::shared_ptr<HybridPerMessageDeflateSpec> HybridZlib::createPerMessageDeflate(const PerMessageDeflateOptions &options)
+    {
+        ZLIB_LOG_DEBUG("HybridZlib", "Creating permessage-deflate codec");
+        return std::make_shared<HybridPerMessageDeflate>(options);
+    }
+
+    std::shared_ptr<HybridContentDecoderSpec> HybridZlib::createContentDecoder(const std::string &encoding, const std::shared_ptr<ArrayBuffer> &ring)
+    {
+        ZLIB_LOG_DEBUG("HybridZlib", "Creating content decoder");
+        return HybridContentDecoder::create(encoding, ring);
+    }
+
+    std::shared_ptr<HybridAbortTokenSpec> HybridZlib::createAbortToken()
+    {
+        return std::make_shared<HybridAbortToken>();
+    }
+
+    std::shared_ptr<HybridCompressedStoreSpec> HybridZlib::createCompressedStore(const std::optional<CompressedStoreOptions> &options)
+    {
+        ZLIB_LOG_DEBUG("HybridZlib", "Creating compressed store");
+        return std::make_shared<HybridCompressedStore>(options);
+    }
+
+    // Metrics
+    void HybridZlib::setMetricsEnabled(bool enabled)
+    {
+        ZlibMetrics::setEnabled(enabled);
+    }
+
+    std::vector<OperationMetrics> HybridZlib::getMetrics()
+    {
+        return ZlibMetrics::snapshot();
+    }
+
+    void HybridZlib::resetMetrics()
+    {
+        ZlibMetrics::reset();
+    }
+
+    // Tuning
+    std::future<TuneResult> HybridZlib::tune(
+        const std::vector<std::shared_ptr<ArrayBuffer>> &samples,
+        const std::optional<TuneObjective> &objective)
+    {
+        // Copy samples while on JS thread
+        std::vector<std::vector<uint8_t>> copies;
+        copies.reserve(samples.size());
+        for (const auto &sample : samples)
+        {
+            const uint8_t *ptr = sample->data();
+            copies.emplace_back(ptr, ptr + sample->size());
+        }
+        TuneObjective goal = objective.value_or(TuneObjective(std::nullopt, std::nullopt, std::nullopt));
+
+        // Runs on its own thread, outside the worker pool
+        return std::async(std::launch::async, [copies = std::move(copies), goal]()
+                          { return ZlibTuner::tune(copies, goal); });
     }
 
 } // namespace margelo::nitro::rnzlib
\ No newline at end of file
@@ -2,6 +2,15 @@
 
 #include <zlib.h>
 #include "HybridZlibSpec.hpp"
+#include "HybridCompressedBuffer.hpp"
+#include "InputView.hpp"
+#include "ZlibCodec.hpp"
+#include "ZlibMetrics.hpp"
+#include "ZlibProcessor.hpp"
+#include "ZlibResultInfo.hpp"
+#include "ZlibTuner.hpp"
+#include <cmath>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -77,7 +86,169 @@ namespace margelo::nitro::rnzlib
             const std::shared_ptr<ArrayBuffer> &data,
             const std::optional<ZlibOptions> &options = std::nullopt) override;
 
-        // Stream methods (unchanged)
+        // Format detecting inflate (gzip, zlib or raw deflate)
+        std::shared_ptr<ArrayBuffer> unzipSync(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        std::future<std::shared_ptr<ArrayBuffer>> unzip(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        // Sync methods writing into dst at dstOffset, returning the bytes written
+        double inflateInto(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::shared_ptr<ArrayBuffer> &dst,
+            std::optional<double> dstOffset = std::nullopt,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        double gunzipInto(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::shared_ptr<ArrayBuffer> &dst,
+            std::optional<double> dstOffset = std::nullopt,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        double deflateInto(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::shared_ptr<ArrayBuffer> &dst,
+            std::optional<double> dstOffset = std::nullopt,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        // UTF-8 text in or out, without TextEncoder/TextDecoder copies in JS
+        std::shared_ptr<ArrayBuffer> deflateString(
+            const std::string &text,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        std::shared_ptr<ArrayBuffer> gzipString(
+            const std::string &text,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        std::string inflateToString(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        std::string gunzipToString(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        // Base64 text out of / into the codec, for JSON and AsyncStorage
+        std::string deflateToBase64(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        std::string gzipToBase64(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        std::shared_ptr<ArrayBuffer> inflateFromBase64(
+            const std::string &base64,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        std::shared_ptr<ArrayBuffer> gunzipFromBase64(
+            const std::string &base64,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        // Output kept native behind a CompressedBuffer handle, input may be one too
+        std::shared_ptr<HybridCompressedBufferSpec> deflateToHandle(
+            const ZlibInput &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        std::shared_ptr<HybridCompressedBufferSpec> gzipToHandle(
+            const ZlibInput &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        std::shared_ptr<HybridCompressedBufferSpec> inflateToHandle(
+            const ZlibInput &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        std::shared_ptr<HybridCompressedBufferSpec> gunzipToHandle(
+            const ZlibInput &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        std::shared_ptr<HybridCompressedBufferSpec> unzipToHandle(
+            const ZlibInput &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        // Output in fixed-size segments instead of one contiguous block
+        std::future<std::vector<std::shared_ptr<ArrayBuffer>>> inflateSegmented(
+            const std::shared_ptr<ArrayBuffer> &data,
+            std::optional<double> segmentSize = std::nullopt,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        std::future<std::vector<std::shared_ptr<ArrayBuffer>>> gunzipSegmented(
+            const std::shared_ptr<ArrayBuffer> &data,
+            std::optional<double> segmentSize = std::nullopt,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        std::future<std::vector<std::shared_ptr<ArrayBuffer>>> unzipSegmented(
+            const std::shared_ptr<ArrayBuffer> &data,
+            std::optional<double> segmentSize = std::nullopt,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        // Sync methods returning the buffer plus native timing, sizes and checksum
+        ZlibResult inflateSyncWithInfo(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        ZlibResult inflateRawSyncWithInfo(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        ZlibResult compressSyncWithInfo(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        ZlibResult deflateSyncWithInfo(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        ZlibResult deflateRawSyncWithInfo(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        ZlibResult gzipSyncWithInfo(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        ZlibResult gunzipSyncWithInfo(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        // Async methods returning the buffer plus native timing, sizes and checksum
+        std::future<ZlibResult> inflateWithInfo(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        std::future<ZlibResult> inflateRawWithInfo(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        std::future<ZlibResult> compressWithInfo(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        std::future<ZlibResult> deflateWithInfo(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        std::future<ZlibResult> deflateRawWithInfo(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        std::future<ZlibResult> gzipWithInfo(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        std::future<ZlibResult> gunzipWithInfo(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        // Experimental speculative parallel inflate, falls back to gunzip
+        std::future<std::shared_ptr<ArrayBuffer>> gunzipParallel(
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options = std::nullopt) override;
+
+        // Stream methods, options are applied like in the one-shot methods
         std::shared_ptr<HybridZlibStreamSpec> createDeflateStream(
             const std::optional<ZlibOptions> &options = std::nullopt) override;
 
@@ -99,14 +270,220 @@ namespace margelo::nitro::rnzlib
         std::shared_ptr<HybridZlibStreamSpec> createUnzipStream(
             const std::optional<ZlibOptions> &options = std::nullopt) override;
 
+        // WebSocket permessage-deflate codec for one connection
+        std::shared_ptr<HybridPerMessageDeflateSpec> createPerMessageDeflate(
+            const PerMessageDeflateOptions &options) override;
+
+        // Incremental HTTP body decoder writing into a caller-provided ring buffer
+        std::shared_ptr<HybridContentDecoderSpec> createContentDecoder(
+            const std::string &encoding,
+            const std::shared_ptr<ArrayBuffer> &ring) override;
+
+        // Cancels one-shot work passed the token as ZlibOptions.signal
+        std::shared_ptr<HybridAbortTokenSpec> createAbortToken() override;
+
+        // Native LRU store of compressed values, with a hot decompressed tier
+        std::shared_ptr<HybridCompressedStoreSpec> createCompressedStore(
+            const std::optional<CompressedStoreOptions> &options) override;
+
+        // Metrics
+        void setMetricsEnabled(bool enabled) override;
+        std::vector<OperationMetrics> getMetrics() override;
+        void resetMetrics() override;
+
+        // Parameter tuning
+        std::future<TuneResult> tune(
+            const std::vector<std::shared_ptr<ArrayBuffer>> &samples,
+            const std::optional<TuneObjective> &objective = std::nullopt) override;
+
     private:
-        // Helper function with additional options parameter
-        std::shared_ptr<ArrayBuffer> processZlib(
+        // One-shot helpers, both run the same templated codec core
+        template <Direction D, Format F>
+        static std::shared_ptr<ArrayBuffer> processZlib(
+            MetricOp op,
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options)
+        {
+            auto input = inputView(data, options);
+            MetricsScope metrics(op, input.size);
+            auto result = runCodec<D, F>(input.data, input.size, CodecParams::from(options));
+            metrics.setBytesOut(result->size());
+            return result;
+        }
+
+        template <Direction D, Format F>
+        static double processZlibInto(
+            MetricOp op,
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::shared_ptr<ArrayBuffer> &dst,
+            std::optional<double> dstOffset,
+            const std::optional<ZlibOptions> &options)
+        {
+            double offset = dstOffset.value_or(0);
+            if (!(offset >= 0 && offset <= static_cast<double>(dst->size())) || offset != std::floor(offset))
+                throw std::runtime_error("dstOffset is outside the destination buffer");
+
+            auto input = inputView(data, options);
+            size_t start = static_cast<size_t>(offset);
+            uint8_t *out = dst->data() + start;
+            size_t capacity = dst->size() - start;
+            // zlib reads input it has already overwritten otherwise
+            auto inBegin = reinterpret_cast<uintptr_t>(input.data);
+            auto outBegin = reinterpret_cast<uintptr_t>(out);
+            if (input.size > 0 && capacity > 0 && inBegin < outBegin + capacity && outBegin < inBegin + input.size)
+                throw std::runtime_error("dst overlaps the input range");
+
+            MetricsScope metrics(op, input.size);
+            size_t written = runCodecInto<D, F>(input.data, input.size, CodecParams::from(options), out, capacity);
+            metrics.setBytesOut(written);
+            return static_cast<double>(written);
+        }
+
+        template <Direction D, Format F>
+        static std::shared_ptr<ArrayBuffer> processString(
+            MetricOp op,
+            const std::string &text,
+            const std::optional<ZlibOptions> &options)
+        {
+            MetricsScope metrics(op, text.size());
+            auto result = runCodec<D, F>(reinterpret_cast<const uint8_t *>(text.data()), text.size(), CodecParams::from(options));
+            metrics.setBytesOut(result->size());
+            return result;
+        }
+
+        template <Direction D, Format F>
+        static std::string processToString(
+            MetricOp op,
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options)
+        {
+            auto input = inputView(data, options);
+            MetricsScope metrics(op, input.size);
+            auto result = runCodecToString<D, F>(input.data, input.size, CodecParams::from(options));
+            metrics.setBytesOut(result.size());
+            return result;
+        }
+
+        template <Direction D, Format F>
+        static std::string processToBase64(
+            MetricOp op,
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options)
+        {
+            auto input = inputView(data, options);
+            MetricsScope metrics(op, input.size);
+            auto result = runCodecToBase64<D, F>(input.data, input.size, CodecParams::from(options));
+            metrics.setBytesOut(result.size());
+            return result;
+        }
+
+        template <Direction D, Format F>
+        static std::shared_ptr<ArrayBuffer> processFromBase64(
+            MetricOp op,
+            const std::string &base64,
+            const std::optional<ZlibOptions> &options)
+        {
+            MetricsScope metrics(op, base64.size());
+            auto bytes = base64Decode(base64.data(), base64.size());
+            auto result = runCodec<D, F>(bytes.data(), bytes.size(), CodecParams::from(options));
+            metrics.setBytesOut(result->size());
+            return result;
+        }
+
+        template <Direction D, Format F>
+        static std::shared_ptr<HybridCompressedBufferSpec> processToHandle(
+            MetricOp op,
+            const ZlibInput &data,
+            const std::optional<ZlibOptions> &options)
+        {
+            auto input = inputView(HybridCompressedBuffer::bytesOf(data), options);
+            MetricsScope metrics(op, input.size);
+            auto result = runCodec<D, F>(input.data, input.size, CodecParams::from(options));
+            metrics.setBytesOut(result->size());
+            return std::make_shared<HybridCompressedBuffer>(result);
+        }
+
+        // Queues a one-shot job at its priority. A job aborted or past its deadline while
+        // queued is rejected as soon as a worker dequeues it, before any zlib init or allocation
+        template <typename Fn>
+        static auto submitCodecJob(CodecParams params, Fn &&fn)
+        {
+            JobPriority priority = params.priority;
+            return WorkerPool::shared().submit([params = std::move(params), fn = std::forward<Fn>(fn)]()
+                                               {
+                                                   params.throwIfCancelled();
+                                                   return fn(params); },
+                                               priority);
+        }
+
+        // Async latency is the time spent on the worker thread, not the time until the promise settles
+        template <Direction D, Format F>
+        static std::future<std::shared_ptr<ArrayBuffer>> processZlibAsync(
+            MetricOp op,
             const std::shared_ptr<ArrayBuffer> &data,
-            int (*zlibFunc)(z_stream *, int),
-            std::function<int(z_stream *, int)> zlibInit,
-            int windowBits,
-            const std::optional<ZlibOptions> &options = std::nullopt);
+            const std::optional<ZlibOptions> &options)
+        {
+            auto processor = std::make_shared<ZlibProcessor>(inputView(data, options));
+            return submitCodecJob(CodecParams::from(options), [op, processor](const CodecParams &params)
+                                  {
+                                      MetricsScope metrics(op, processor->size());
+                                      auto result = processor->process<D, F>(params);
+                                      metrics.setBytesOut(result->size());
+                                      return result; });
+        }
+
+        template <Direction D, Format F>
+        static std::future<std::vector<std::shared_ptr<ArrayBuffer>>> processSegmentedAsync(
+            MetricOp op,
+            const std::shared_ptr<ArrayBuffer> &data,
+            std::optional<double> segmentSize,
+            const std::optional<ZlibOptions> &options)
+        {
+            size_t size = SegmentedOutput::segmentSize(segmentSize);
+            auto processor = std::make_shared<ZlibProcessor>(inputView(data, options));
+            return submitCodecJob(CodecParams::from(options), [op, processor, size](const CodecParams &params)
+                                  {
+                                      MetricsScope metrics(op, processor->size());
+                                      auto segments = processor->processSegmented<D, F>(params, size);
+                                      metrics.setBytesOut(totalSize(segments));
+                                      return segments; });
+        }
+
+        static size_t totalSize(const std::vector<std::shared_ptr<ArrayBuffer>> &segments)
+        {
+            size_t total = 0;
+            for (const auto &segment : segments)
+                total += segment->size();
+            return total;
+        }
+
+        template <Direction D, Format F>
+        static ZlibResult processZlibWithInfo(
+            MetricOp op,
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options)
+        {
+            auto input = inputView(data, options);
+            MetricsScope metrics(op, input.size);
+            auto result = runCodecWithInfo<D, F>(input.data, input.size, CodecParams::from(options));
+            metrics.setBytesOut(result.buffer->size());
+            return result;
+        }
+
+        template <Direction D, Format F>
+        static std::future<ZlibResult> processZlibWithInfoAsync(
+            MetricOp op,
+            const std::shared_ptr<ArrayBuffer> &data,
+            const std::optional<ZlibOptions> &options)
+        {
+            auto processor = std::make_shared<ZlibProcessor>(inputView(data, options));
+            return submitCodecJob(CodecParams::from(options), [op, processor](const CodecParams &params)
+                                  {
+                                      MetricsScope metrics(op, processor->size());
+                                      auto result = processor->processWithInfo<D, F>(params);
+                                      metrics.setBytesOut(result.buffer->size());
+                                      return result; });
+        }
 
         // std::vector<uint8_t> copyBufferData(const std::shared_ptr<ArrayBuffer> &buffer)
         // {
@@ -133,52 +510,6 @@ namespace margelo::nitro::rnzlib
         //         [=]()
         //         { delete[] bufferData; });
         // }
-
-        // Helper to extract values from ZlibOptions with defaults
-        static int getCompressionLevel(const std::optional<ZlibOptions> &options)
-        {
-            if (!options.has_value() || !options->level.has_value())
-            {
-                return Z_DEFAULT_COMPRESSION;
-            }
-            return static_cast<int>(options->level.value());
-        }
-
-        static int getStrategy(const std::optional<ZlibOptions> &options)
-        {
-            if (!options.has_value() || !options->strategy.has_value())
-            {
-                return Z_DEFAULT_STRATEGY;
-            }
-            return static_cast<int>(options->strategy.value());
-        }
-
-        static int getWindowBits(const std::optional<ZlibOptions> &options, int defaultBits = 15)
-        {
-            if (!options.has_value() || !options->windowBits.has_value())
-            {
-                return defaultBits;
-            }
-            return static_cast<int>(options->windowBits.value());
-        }
-
-        static int getMemLevel(const std::optional<ZlibOptions> &options)
-        {
-            if (!options.has_value() || !options->memLevel.has_value())
-            {
-                return 8; // Default memory level
-            }
-            return static_cast<int>(options->memLevel.value());
-        }
-
-        static int getChunkSize(const std::optional<ZlibOptions> &options)
-        {
-            if (!options.has_value() || !options->chunkSize.has_value())
-            {
-                return 16 * 1024; // Default chunk size (16KB)
-            }
-            return static_cast<int>(options->chunkSize.value());
-        }
     };
 
 } // namespace margelo::nitro::rnzlib
\ No newline at end of file
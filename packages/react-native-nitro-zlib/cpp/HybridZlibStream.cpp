@@ -1,96 +1,215 @@
 #include "HybridZlibStream.hpp"
 #include <zlib.h>
+#include <algorithm>
+#include <climits>
+#include <cstring>
 #include <vector>
 #include <stdexcept>
-#include <NitroModules/NitroLogger.hpp>
+#include "ZlibTrace.hpp"
+#include "ZlibMetrics.hpp"
+#include "FormatSniffer.hpp"
 
 namespace margelo::nitro::rnzlib
 {
 
-    void HybridZlibStream::initStream(int level, bool deflate)
+    CodecParams HybridZlibStream::streamParams(Direction direction, const std::optional<ZlibOptions> &options)
     {
-        Logger::log(LogLevel::Debug, "HybridZlibStream", "Initializing stream: level = %d, deflate = %d", level, deflate);
+        CodecParams params = CodecParams::from(options);
+        if (!params.lowMemory)
+        {
+            return params;
+        }
+        if (!options->memLevel.has_value())
+            params.memLevel = LOW_MEMORY_MEM_LEVEL;
+        if (!options->chunkSize.has_value())
+            params.chunkSize = LOW_MEMORY_CHUNK_SIZE;
+        // The inflate window has to fit the peer's, only deflate can pick a smaller one
+        if (direction == Direction::Deflate && !options->windowBits.has_value())
+            params.windowBits = LOW_MEMORY_WINDOW_BITS;
+        return params;
+    }
 
-        if (_initialized)
+    std::shared_ptr<HybridZlibStream> HybridZlibStream::create(Direction direction, Format format, const std::optional<ZlibOptions> &options)
+    {
+        CodecParams params = streamParams(direction, options);
+        ZLIB_LOG_DEBUG("HybridZlibStream",
+                    "Creating HybridZlibStream: deflate = %d, level = %d, windowBits = %d, memLevel = %d, strategy = %d, lowMemory = %d",
+                    direction == Direction::Deflate, params.level, params.windowBits, params.memLevel, params.strategy, params.lowMemory);
+        auto instance = std::make_shared<HybridZlibStream>();
+        instance->configure(params);
+        instance->_deflate = direction == Direction::Deflate;
+        instance->_framedWindowBits = framedWindowBits(format, params.windowBits);
+
+        // Low-memory streams also initialize here so bad parameters still throw, then go idle
+        int ret = instance->activate();
+        if (ret != Z_OK)
         {
-            Logger::log(LogLevel::Debug, "HybridZlibStream", "Stream already initialized, resetting");
-            if (_zstream)
-            {
-                if (_deflate)
-                    deflateEnd(_zstream.get());
-                else
-                    inflateEnd(_zstream.get());
-            }
+            throw std::runtime_error(std::string("Failed to initialize zlib stream: ") + zError(ret));
         }
+        if (instance->_lowMemory)
+        {
+            instance->releaseStream();
+        }
+        return instance;
+    }
 
-        _zstream = std::make_unique<z_stream>();
-        memset(_zstream.get(), 0, sizeof(z_stream));
+    std::shared_ptr<HybridZlibStream> HybridZlibStream::createUnzip(const std::optional<ZlibOptions> &options)
+    {
+        CodecParams params = streamParams(Direction::Inflate, options);
+        ZLIB_LOG_DEBUG("HybridZlibStream", "Creating format detecting HybridZlibStream: windowBits = %d", params.windowBits);
 
-        int ret = deflate ? deflateInit(_zstream.get(), level) : inflateInit(_zstream.get());
+        // The real init waits for the first bytes, probe now so bad parameters throw here like in create()
+        z_stream probe;
+        std::memset(&probe, 0, sizeof(probe));
+        int ret = inflateInit2(&probe, framedWindowBits(Format::Auto, params.windowBits));
         if (ret != Z_OK)
         {
-            Logger::log(LogLevel::Error, "HybridZlibStream", "Failed to initialize zlib stream: %d", ret);
-            _zstream.reset();
-            reportError("Failed to initialize zlib stream");
-            _initialized = false;
-            return;
+            throw std::runtime_error(std::string("Failed to initialize zlib stream: ") + zError(ret));
         }
+        inflateEnd(&probe);
 
-        _initialized = true;
-        _deflate = deflate;
-        Logger::log(LogLevel::Debug, "HybridZlibStream", "Stream initialized successfully. Initialized: %d, Deflate: %d", _initialized, _deflate);
+        auto instance = std::make_shared<HybridZlibStream>();
+        instance->configure(params);
+        instance->_autoFormat = true;
+        instance->_detectFormat = true;
+        return instance;
+    }
+
+    void HybridZlibStream::configure(const CodecParams &params)
+    {
+        _level = params.level;
+        _windowBits = params.windowBits;
+        _memLevel = params.memLevel;
+        _strategy = params.strategy;
+        _chunkSize = params.chunkSize;
+        _dictionary = params.dictionary;
+        _lowMemory = params.lowMemory;
     }
 
-    void HybridZlibStream::initWithWindowBits(int windowBits)
+    void HybridZlibStream::releaseStream()
     {
-        if (_initialized)
+        if (_initialized && _zstream)
         {
-            if (_zstream)
-            {
-                if (_deflate)
-                    deflateEnd(_zstream.get());
-                else
-                    inflateEnd(_zstream.get());
-            }
-            _initialized = false;
+            if (_deflate)
+                deflateEnd(_zstream.get());
+            else
+                inflateEnd(_zstream.get());
         }
+        _zstream.reset();
+        _initialized = false;
+    }
 
-        _zstream = std::make_unique<z_stream>();
-        memset(_zstream.get(), 0, sizeof(z_stream));
+    // (Re)creates the zlib state for the stream's direction and framing
+    int HybridZlibStream::activate()
+    {
+        return _deflate ? initDeflate(_framedWindowBits) : initInflate(_framedWindowBits);
+    }
+
+    std::vector<uint8_t> &HybridZlibStream::outputBuffer()
+    {
+        if (!_lowMemory)
+        {
+            return _outBuffer;
+        }
+        // Shared by all low-memory streams on this thread; chunks are copied out before any callback runs
+        thread_local std::vector<uint8_t> shared;
+        return shared;
+    }
+
+    void HybridZlibStream::emitChunk(const uint8_t *data, size_t length)
+    {
+        if (length == 0 || !_dataCallback)
+        {
+            return;
+        }
+        auto chunk = createArrayBuffer(length);
+        std::memcpy(chunk->data(), data, length);
+        _dataCallback(chunk);
     }
 
-    void HybridZlibStream::initDeflateWithWindowBits(int level, int windowBits)
+    int HybridZlibStream::initDeflate(int windowBits)
     {
-        initWithWindowBits(windowBits);
+        releaseStream();
+        _zstream = std::make_unique<z_stream>();
+        memset(_zstream.get(), 0, sizeof(z_stream));
 
-        int ret = deflateInit2(_zstream.get(), level, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY);
+        int ret = deflateInit2(_zstream.get(), _level, Z_DEFLATED, windowBits, _memLevel, _strategy);
         if (ret != Z_OK)
         {
-            Logger::log(LogLevel::Error, "HybridZlibStream", "Failed to initialize deflate stream with window bits: %d", ret);
+            ZLIB_LOG_ERROR("HybridZlibStream", "Failed to initialize deflate stream: %d", ret);
             _zstream.reset();
-            reportError("Failed to initialize deflate stream");
-            return;
+            return ret;
         }
 
         _initialized = true;
         _deflate = true;
+        _rawFraming = windowBits < 0;
+        // The peer's inflater only saw the dictionary before the first message
+        if (_continuesStream)
+        {
+            _continuesStream = false;
+            return Z_OK;
+        }
+        return applyDictionary();
     }
 
-    void HybridZlibStream::initInflateWithWindowBits(int windowBits)
+    int HybridZlibStream::initInflate(int windowBits)
     {
-        initWithWindowBits(windowBits);
+        releaseStream();
+        _zstream = std::make_unique<z_stream>();
+        memset(_zstream.get(), 0, sizeof(z_stream));
 
         int ret = inflateInit2(_zstream.get(), windowBits);
         if (ret != Z_OK)
         {
-            Logger::log(LogLevel::Error, "HybridZlibStream", "Failed to initialize inflate stream with window bits: %d", ret);
+            ZLIB_LOG_ERROR("HybridZlibStream", "Failed to initialize inflate stream: %d", ret);
             _zstream.reset();
-            reportError("Failed to initialize inflate stream");
-            return;
+            return ret;
         }
 
         _initialized = true;
         _deflate = false;
+        _rawFraming = windowBits < 0;
+        return applyDictionary();
+    }
+
+    // Deflate and raw inflate take the dictionary up front, zlib inflate asks for it in step()
+    int HybridZlibStream::applyDictionary()
+    {
+        if (_dictionary.empty())
+            return Z_OK;
+        if (_deflate)
+            return deflateSetDictionary(_zstream.get(), _dictionary.data(), static_cast<uInt>(_dictionary.size()));
+        if (_rawFraming)
+            return inflateSetDictionary(_zstream.get(), _dictionary.data(), static_cast<uInt>(_dictionary.size()));
+        return Z_OK;
+    }
+
+    int HybridZlibStream::step(int flush)
+    {
+        if (_deflate)
+            return deflate(_zstream.get(), flush);
+
+        int ret = inflate(_zstream.get(), flush);
+        if (ret == Z_NEED_DICT && !_dictionary.empty() &&
+            inflateSetDictionary(_zstream.get(), _dictionary.data(), static_cast<uInt>(_dictionary.size())) == Z_OK)
+        {
+            ret = inflate(_zstream.get(), flush);
+        }
+        return ret;
+    }
+
+    void HybridZlibStream::startDetectedInflate()
+    {
+        DetectedFormat format = sniffFormat(_header.data(), _header.size());
+        ZLIB_LOG_DEBUG("HybridZlibStream", "Detected format %d from %zu header bytes", static_cast<int>(format), _header.size());
+        _detectFormat = false;
+        _framedWindowBits = sniffedWindowBits(format, _windowBits);
+        if (activate() != Z_OK)
+        {
+            releaseStream();
+            reportError("Failed to initialize inflate stream");
+        }
     }
 
     void HybridZlibStream::reportError(const std::string &message)
@@ -102,9 +221,48 @@ namespace margelo::nitro::rnzlib
         }
     }
 
-    bool HybridZlibStream::write(const std::shared_ptr<ArrayBuffer> &chunk)
+    bool HybridZlibStream::write(const std::shared_ptr<ArrayBuffer> &chunk, std::optional<double> byteOffset, std::optional<double> byteLength)
     {
-        Logger::log(LogLevel::Debug, "HybridZlibStream", "Write called. Initialized: %d, Deflate: %d", _initialized, _deflate);
+        InputView input = chunk ? inputView(chunk, byteOffset, byteLength) : InputView{nullptr, 0};
+
+        if (_detectFormat)
+        {
+            if (input.size == 0)
+            {
+                return true;
+            }
+            // Hold input back until the header bytes tell gzip, zlib and raw apart
+            _header.insert(_header.end(), input.data, input.data + input.size);
+            if (sniffFormat(_header.data(), _header.size()) == DetectedFormat::NeedMoreInput)
+            {
+                return true;
+            }
+            startDetectedInflate();
+            std::vector<uint8_t> pending = std::move(_header);
+            _header.clear();
+            return _initialized && writeBytes(pending.data(), pending.size());
+        }
+
+        if (_finished)
+        {
+            // Input after the end of the compressed stream is not consumed
+            return input.size == 0;
+        }
+
+        if (!_initialized && _lowMemory && !_ended && !_autoFormat)
+        {
+            if (input.size == 0)
+            {
+                return true;
+            }
+            // Idle low-memory stream, bring the zlib state back
+            if (activate() != Z_OK)
+            {
+                releaseStream();
+                reportError("Failed to initialize zlib stream");
+                return false;
+            }
+        }
 
         if (!_initialized || !_zstream)
         {
@@ -112,71 +270,103 @@ namespace margelo::nitro::rnzlib
             return false;
         }
 
-        if (!chunk || chunk->size() == 0)
+        if (input.size == 0)
         {
-            Logger::log(LogLevel::Debug, "HybridZlibStream", "Empty chunk, returning");
             return true;
         }
 
-        Logger::log(LogLevel::Debug, "HybridZlibStream", "Writing chunk of size: %zu", chunk->size());
+        return writeBytes(input.data, input.size);
+    }
 
-        _zstream->avail_in = static_cast<uInt>(chunk->size());
-        _zstream->next_in = static_cast<Bytef *>(chunk->data());
+    bool HybridZlibStream::writeBytes(const uint8_t *data, size_t length)
+    {
+        ZLIB_TRACE("stream.write", length, _deflate);
+        MetricsScope metrics(MetricOp::streamWrite, length);
+        size_t produced = 0;
+        std::vector<uint8_t> &out = outputBuffer();
 
+        // avail_in is a uInt, so chunks over 4 GB go in as several windows
+        size_t unfed = length;
         do
         {
-            _outBuffer.resize(CHUNK_SIZE);
-            _zstream->avail_out = static_cast<uInt>(_outBuffer.size());
-            _zstream->next_out = _outBuffer.data();
-
-            int ret = _deflate ? deflate(_zstream.get(), Z_NO_FLUSH) : inflate(_zstream.get(), Z_NO_FLUSH);
+            uInt window = static_cast<uInt>(std::min<size_t>(unfed, UINT_MAX));
+            _zstream->avail_in = window;
+            _zstream->next_in = const_cast<Bytef *>(data + (length - unfed));
+            unfed -= window;
 
-            if (ret == Z_STREAM_ERROR)
+            do
             {
-                throw std::runtime_error("Z_STREAM_ERROR: inconsistent stream state");
-            }
+                out.resize(_chunkSize);
+                _zstream->avail_out = static_cast<uInt>(out.size());
+                _zstream->next_out = out.data();
+
+                int ret = step(Z_NO_FLUSH);
+
+                if (ret == Z_STREAM_ERROR)
+                {
+                    throw std::runtime_error("Z_STREAM_ERROR: inconsistent stream state");
+                }
+
+                if (ret == Z_BUF_ERROR && _zstream->avail_in == 0)
+                {
+                    // If Z_BUF_ERROR occurs and there's no input left, it might mean we need more output space.
+                    break;
+                }
+
+                unsigned have = static_cast<unsigned>(out.size()) - _zstream->avail_out;
+                ZLIB_TRACE("stream.chunk", have, _zstream->avail_in);
+                produced += have;
+                emitChunk(out.data(), have);
+
+                if (ret == Z_STREAM_END)
+                {
+                    _finished = true;
+                    break;
+                }
+            } while (_zstream->avail_out == 0);
+            // Input left in the window, or the end of the stream, means the rest is not fed either
+        } while (unfed > 0 && _zstream->avail_in == 0 && !_finished);
+
+        metrics.setBytesOut(produced);
+        bool consumed = unfed == 0 && _zstream->avail_in == 0;
+        // Message boundary for inflate: nothing later can refer back into this stream
+        if (_finished && _lowMemory)
+        {
+            releaseStream();
+        }
+        return consumed;
+    }
 
-            if (ret == Z_BUF_ERROR && _zstream->avail_in == 0)
-            {
-                // If Z_BUF_ERROR occurs and there's no input left, it might mean we need more output space.
-                break;
-            }
+    void HybridZlibStream::end()
+    {
 
-            unsigned have = static_cast<unsigned>(_outBuffer.size()) - _zstream->avail_out;
-            if (have > 0 && _dataCallback)
-            {
-                uint8_t *buffer = new uint8_t[have];
-                std::memcpy(buffer, _outBuffer.data(), have);
-                auto outChunk = std::make_shared<NativeArrayBuffer>(buffer, have, [=]()
-                                                                    { delete[] buffer; });
-                _dataCallback(outChunk);
-            }
-        } while (_zstream->avail_out == 0);
+        ZLIB_LOG_DEBUG("HybridZlibStream", "End called. Initialized: %d, Deflate: %d", _initialized, _deflate);
 
-        return _zstream->avail_in == 0;
-    }
+        if (_detectFormat)
+        {
+            // Fewer header bytes than needed to decide, inflate whatever arrived
+            startDetectedInflate();
+            std::vector<uint8_t> pending = std::move(_header);
+            _header.clear();
+            if (_initialized && !pending.empty())
+                writeBytes(pending.data(), pending.size());
+        }
 
-    void HybridZlibStream::processOutput(int ret)
-    {
-        if (ret == Z_STREAM_ERROR)
+        if (_finished && !_initialized)
         {
-            reportError("Z_STREAM_ERROR: inconsistent stream state");
+            // Low-memory inflate stream, released once its compressed stream ended
+            _ended = true;
+            if (_endCallback)
+            {
+                _endCallback();
+            }
             return;
         }
 
-        unsigned have = static_cast<unsigned>(_outBuffer.size()) - _zstream->avail_out;
-        if (have > 0 && _dataCallback)
+        if (!_initialized && _lowMemory && !_ended && !_autoFormat && activate() != Z_OK)
         {
-            auto outChunk = std::make_shared<NativeArrayBuffer>(_outBuffer.data(), have, [=]()
-                                                                { delete[] _outBuffer.data(); });
-            _dataCallback(outChunk);
+            releaseStream();
         }
-    }
-
-    void HybridZlibStream::end()
-    {
-
-        Logger::log(LogLevel::Debug, "HybridZlibStream", "End called. Initialized: %d, Deflate: %d", _initialized, _deflate);
 
         if (!_initialized || !_zstream)
         {
@@ -184,14 +374,17 @@ namespace margelo::nitro::rnzlib
             return;
         }
 
-        _outBuffer.resize(CHUNK_SIZE);
+        MetricsScope metrics(MetricOp::streamEnd, 0);
+        size_t produced = 0;
+        std::vector<uint8_t> &out = outputBuffer();
         int ret;
         do
         {
-            _zstream->avail_out = static_cast<uInt>(_outBuffer.size());
-            _zstream->next_out = _outBuffer.data();
+            out.resize(_chunkSize);
+            _zstream->avail_out = static_cast<uInt>(out.size());
+            _zstream->next_out = out.data();
 
-            ret = _deflate ? deflate(_zstream.get(), Z_FINISH) : inflate(_zstream.get(), Z_FINISH);
+            ret = step(Z_FINISH);
 
             if (ret == Z_STREAM_ERROR)
             {
@@ -199,62 +392,77 @@ namespace margelo::nitro::rnzlib
                 break;
             }
 
-            unsigned have = static_cast<unsigned>(_outBuffer.size()) - _zstream->avail_out;
-            if (have > 0 && _dataCallback)
+            unsigned have = static_cast<unsigned>(out.size()) - _zstream->avail_out;
+            produced += have;
+            emitChunk(out.data(), have);
+
+            // Corrupt or truncated input never reaches Z_STREAM_END
+            if (ret == Z_DATA_ERROR || ret == Z_MEM_ERROR || ret == Z_NEED_DICT || (ret == Z_BUF_ERROR && have == 0))
             {
-                auto outChunk = std::make_shared<NativeArrayBuffer>(_outBuffer.data(), have, [=]() { /* No need to delete _outBuffer, it's reused */ });
-                _dataCallback(outChunk);
+                reportError(_zstream->msg != nullptr ? _zstream->msg : "Unexpected end of input");
+                break;
             }
         } while (ret != Z_STREAM_END);
+        metrics.setBytesOut(produced);
 
-        // Clean up
-        if (_deflate)
-        {
-            deflateEnd(_zstream.get());
-        }
-        else
-        {
-            inflateEnd(_zstream.get());
-        }
-
-        _zstream.reset();
-        _initialized = false;
+        releaseStream();
+        _ended = true;
 
         if (_endCallback)
         {
             _endCallback();
         }
 
-        Logger::log(LogLevel::Debug, "HybridZlibStream", "Stream ended successfully");
+        ZLIB_LOG_DEBUG("HybridZlibStream", "Stream ended successfully");
     }
 
     void HybridZlibStream::flush(std::optional<double> kind)
     {
+        if (_detectFormat)
+        {
+            return; // nothing can be decoded before the format is known
+        }
+
+        if (!_initialized || !_zstream)
+        {
+            if (!_lowMemory || _ended)
+            {
+                reportError("Stream not initialized");
+            }
+            return; // an idle low-memory stream has nothing buffered
+        }
+
         int flushKind = kind.has_value() ? static_cast<int>(kind.value()) : Z_SYNC_FLUSH;
-        std::vector<uint8_t> outBuffer(16384); // 16KB buffer
+        std::vector<uint8_t> &out = outputBuffer();
+        MetricsScope metrics(MetricOp::streamFlush, 0);
+        size_t produced = 0;
 
         do
         {
-            _zstream->avail_out = static_cast<uInt>(outBuffer.size());
-            _zstream->next_out = outBuffer.data();
+            out.resize(_chunkSize);
+            _zstream->avail_out = static_cast<uInt>(out.size());
+            _zstream->next_out = out.data();
 
-            int ret = _deflate ? deflate(_zstream.get(), flushKind) : inflate(_zstream.get(), flushKind);
+            int ret = step(flushKind);
 
             if (ret == Z_STREAM_ERROR)
             {
                 throw std::runtime_error("Z_STREAM_ERROR: inconsistent stream state");
             }
 
-            unsigned have = static_cast<unsigned>(outBuffer.size()) - _zstream->avail_out;
-            if (have > 0)
-            {
-                uint8_t *buffer = new uint8_t[have];
-                std::memcpy(buffer, outBuffer.data(), have);
-                auto outChunk = std::make_shared<NativeArrayBuffer>(buffer, have, [=]()
-                                                                    { delete[] buffer; });
-                _dataCallback(outChunk);
-            }
+            unsigned have = static_cast<unsigned>(out.size()) - _zstream->avail_out;
+            produced += have;
+            emitChunk(out.data(), have);
         } while (_zstream->avail_out == 0);
+        metrics.setBytesOut(produced);
+
+        // After a full flush raw deflate output never refers back, so a fresh deflater
+        // can continue the same stream later. Zlib/gzip framing needs the running checksum.
+        if (_lowMemory && _deflate && _rawFraming && flushKind == Z_FULL_FLUSH)
+        {
+            releaseStream();
+            _continuesStream = true;
+        }
     }
 
     void HybridZlibStream::onData(const std::function<void(const std::shared_ptr<ArrayBuffer> &chunk)> &callback)
@@ -279,6 +487,14 @@ namespace margelo::nitro::rnzlib
             throw std::runtime_error("params() is only supported for deflate streams");
         }
 
+        // Kept for idle low-memory streams, which re-create their state later
+        _level = static_cast<int>(level);
+        _strategy = static_cast<int>(strategy);
+        if (!_initialized || !_zstream)
+        {
+            return;
+        }
+
         int ret = deflateParams(_zstream.get(), static_cast<int>(level), static_cast<int>(strategy));
         if (ret != Z_OK)
         {
@@ -289,6 +505,26 @@ namespace margelo::nitro::rnzlib
 
     void HybridZlibStream::reset()
     {
+        _finished = false;
+        _continuesStream = false;
+
+        if (_autoFormat)
+        {
+            // The next payload may use a different format, detect again
+            releaseStream();
+            _detectFormat = true;
+            _header.clear();
+            return;
+        }
+
+        if (_lowMemory)
+        {
+            // Same as deflateReset/inflateReset: the next write starts a fresh stream
+            releaseStream();
+            _ended = false;
+            return;
+        }
+
         int ret;
         if (_deflate)
         {
@@ -298,6 +534,11 @@ namespace margelo::nitro::rnzlib
         {
             ret = inflateReset(_zstream.get());
         }
+        // Resetting drops the dictionary along with the window
+        if (ret == Z_OK)
+        {
+            ret = applyDictionary();
+        }
 
         if (ret != Z_OK)
         {
@@ -315,6 +556,10 @@ namespace margelo::nitro::rnzlib
 
     double HybridZlibStream::getMemorySize()
     {
+        if (!_zstream)
+        {
+            return static_cast<double>(_header.size());
+        }
         return static_cast<double>(_zstream->total_in + _zstream->total_out);
     }
 
@@ -4,6 +4,9 @@
 
 #include "HybridZlibStreamSpec.hpp"
 #include <NitroModules/ArrayBuffer.hpp>
+#include "ZlibCodec.hpp"
+#include "InputView.hpp"
+#include "ZlibTrace.hpp"
 #include <zlib.h>
 #include <functional>
 #include <memory>
@@ -15,8 +18,9 @@ namespace margelo::nitro::rnzlib
     {
     public:
         HybridZlibStream() : HybridObject(TAG) {}
+        ~HybridZlibStream() override { releaseStream(); }
 
-        bool write(const std::shared_ptr<ArrayBuffer> &chunk) override;
+        bool write(const std::shared_ptr<ArrayBuffer> &chunk, std::optional<double> byteOffset, std::optional<double> byteLength) override;
         void end() override;
         void flush(std::optional<double> kind) override;
         void onData(const std::function<void(const std::shared_ptr<ArrayBuffer> &chunk)> &callback) override;
@@ -26,42 +30,67 @@ namespace margelo::nitro::rnzlib
         void reset() override;
         double getMemorySize() override;
 
-        static std::shared_ptr<HybridZlibStream> create(int level, bool deflate, int windowBits = 15)
-        {
-            Logger::log(LogLevel::Debug, "HybridZlibStream",
-                        "Creating HybridZlibStream: level = %d, deflate = %d, windowBits = %d",
-                        level, deflate, windowBits);
-            auto instance = std::make_shared<HybridZlibStream>();
-            if (deflate)
-            {
-                instance->initDeflateWithWindowBits(level, windowBits);
-            }
-            else
-            {
-                instance->initInflateWithWindowBits(windowBits);
-            }
-            return instance;
-        }
+        /**
+         * Streams take the same resolved options as the one-shot APIs: level,
+         * windowBits, memLevel, strategy, chunkSize (output chunk size) and
+         * dictionary, plus the memory profile. Throws when zlib rejects the
+         * parameters.
+         */
+        static std::shared_ptr<HybridZlibStream> create(Direction direction, Format format, const std::optional<ZlibOptions> &options);
+
+        // Inflate stream that picks gzip, zlib or raw deflate once the first header bytes arrive
+        static std::shared_ptr<HybridZlibStream> createUnzip(const std::optional<ZlibOptions> &options);
+
+        // ZlibMemoryProfile.LOW defaults, explicit options take precedence
+        static constexpr int LOW_MEMORY_WINDOW_BITS = 10;
+        static constexpr int LOW_MEMORY_MEM_LEVEL = 2;
+        static constexpr size_t LOW_MEMORY_CHUNK_SIZE = 4 * 1024;
 
     private:
-        void initStream(int level, bool deflate);
-        void processOutput(int ret);
         std::shared_ptr<ArrayBuffer> createArrayBuffer(size_t size);
         void reportError(const std::string &message);
 
-        void initWithWindowBits(int windowBits);
-        void initDeflateWithWindowBits(int level, int windowBits);
-        void initInflateWithWindowBits(int windowBits);
+        static CodecParams streamParams(Direction direction, const std::optional<ZlibOptions> &options);
+
+        void configure(const CodecParams &params);
+        void releaseStream();
+        int activate();
+        int initDeflate(int windowBits);
+        int initInflate(int windowBits);
+        int applyDictionary();
+        int step(int flush);
+        void startDetectedInflate();
+        bool writeBytes(const uint8_t *data, size_t length);
+        std::vector<uint8_t> &outputBuffer();
+        void emitChunk(const uint8_t *data, size_t length);
 
         std::unique_ptr<z_stream> _zstream;
-        bool _deflate;
-        bool _initialized;
+        bool _deflate = false;
+        bool _initialized = false;
+        // Unzip streams: _autoFormat for the stream's lifetime, _detectFormat until the format is known
+        bool _autoFormat = false;
+        bool _detectFormat = false;
+        std::vector<uint8_t> _header;
+        // Options the stream was created with, kept for reset() and format detection
+        int _level = Z_DEFAULT_COMPRESSION;
+        int _windowBits = 15;
+        int _memLevel = 8;
+        int _strategy = Z_DEFAULT_STRATEGY;
+        size_t _chunkSize = 16 * 1024;
+        std::vector<uint8_t> _dictionary;
+        bool _rawFraming = false;
+        // Low-memory streams drop their zlib state while idle and re-create it from these
+        bool _lowMemory = false;
+        bool _ended = false;
+        // Inflate reached the end of the compressed stream, low-memory streams release their state then
+        bool _finished = false;
+        // Raw deflater re-created after a full flush, the dictionary only applies at stream start
+        bool _continuesStream = false;
+        int _framedWindowBits = 15;
         std::vector<uint8_t> _outBuffer;
         std::function<void(const std::shared_ptr<ArrayBuffer> &chunk)> _dataCallback;
         std::function<void()> _endCallback;
         std::function<void(const Error &error)> _errorCallback;
-
-        static constexpr size_t CHUNK_SIZE = 16384; // 16KB
     };
 
 } // namespace margelo::nitro::rnzlib
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include "ZlibOptions.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+
+namespace margelo::nitro::rnzlib
+{
+
+    // A byte range inside an ArrayBuffer, read in place
+    struct InputView
+    {
+        const uint8_t *data;
+        size_t size;
+    };
+
+    /**
+     * byteOffset/byteLength pick a sub-range of `buffer`, so a payload inside a
+     * larger frame needs no ArrayBuffer.slice() copy in JS. byteLength defaults
+     * to the rest of the buffer. Throws when the range doesn't fit.
+     */
+    inline InputView inputView(const std::shared_ptr<ArrayBuffer> &buffer, std::optional<double> byteOffset,
+                               std::optional<double> byteLength)
+    {
+        size_t total = buffer->size();
+        double offset = byteOffset.value_or(0);
+        if (!(offset >= 0 && offset <= static_cast<double>(total)) || offset != std::floor(offset))
+            throw std::runtime_error("byteOffset is outside the input buffer");
+
+        size_t start = static_cast<size_t>(offset);
+        double length = byteLength.value_or(static_cast<double>(total - start));
+        if (!(length >= 0 && length <= static_cast<double>(total - start)) || length != std::floor(length))
+            throw std::runtime_error("byteLength reaches past the end of the input buffer");
+
+        return InputView{buffer->data() + start, static_cast<size_t>(length)};
+    }
+
+    inline InputView inputView(const std::shared_ptr<ArrayBuffer> &buffer, const std::optional<ZlibOptions> &options)
+    {
+        if (!options.has_value())
+            return InputView{buffer->data(), buffer->size()};
+        return inputView(buffer, options->byteOffset, options->byteLength);
+    }
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,653 @@
+#include "ParallelInflate.hpp"
+#include "WorkerPool.hpp"
+#include <zlib.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace margelo::nitro::rnzlib
+{
+    namespace
+    {
+        constexpr size_t WINDOW_SIZE = 32768;
+        // Output symbols >= PLACEHOLDER_BASE refer to byte (symbol - PLACEHOLDER_BASE)
+        // of the unknown window preceding a chunk.
+        constexpr uint16_t PLACEHOLDER_BASE = 256;
+        constexpr uint64_t NO_STOP = UINT64_MAX;
+
+        constexpr uint16_t LENGTH_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                              35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+        constexpr uint8_t LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                              3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+        constexpr uint16_t DIST_BASE[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129,
+                                            193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097,
+                                            6145, 8193, 12289, 16385, 24577};
+        constexpr uint8_t DIST_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6,
+                                            6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+        constexpr uint8_t CODE_LENGTH_ORDER[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+        // LSB-first bit reader. Reading past the end yields zero bits; callers
+        // detect this by comparing tell() against the end of the input.
+        class BitReader
+        {
+        public:
+            BitReader(const uint8_t *data, size_t size, uint64_t bitPos) : _data(data), _size(size) { seek(bitPos); }
+
+            void seek(uint64_t bitPos)
+            {
+                _pos = static_cast<size_t>(bitPos >> 3);
+                _buf = 0;
+                _count = 0;
+                refill();
+                consume(static_cast<unsigned>(bitPos & 7));
+            }
+
+            uint64_t tell() const { return static_cast<uint64_t>(_pos) * 8 - _count; }
+
+            void need(unsigned n)
+            {
+                if (_count < n)
+                    refill();
+            }
+
+            uint32_t peek(unsigned n) const { return static_cast<uint32_t>(_buf & ((1ull << n) - 1)); }
+
+            void consume(unsigned n)
+            {
+                _buf >>= n;
+                _count -= n;
+            }
+
+            uint32_t bits(unsigned n)
+            {
+                if (n == 0)
+                    return 0;
+                need(n);
+                uint32_t v = peek(n);
+                consume(n);
+                return v;
+            }
+
+            void alignToByte() { consume(_count & 7); }
+
+        private:
+            void refill()
+            {
+                while (_count <= 56)
+                {
+                    uint64_t byte = _pos < _size ? _data[_pos] : 0;
+                    _buf |= byte << _count;
+                    _pos++;
+                    _count += 8;
+                }
+            }
+
+            const uint8_t *_data;
+            size_t _size;
+            size_t _pos = 0;
+            uint64_t _buf = 0;
+            unsigned _count = 0;
+        };
+
+        // Canonical Huffman decoder with a direct lookup table for short codes and
+        // a bit-by-bit fallback for the rest.
+        class Huffman
+        {
+        public:
+            static constexpr unsigned FAST_BITS = 10;
+
+            // Mirrors zlib's inflate_table() rules: over-subscribed sets are
+            // rejected, incomplete sets only allowed for a single 1-bit code.
+            bool build(const uint8_t *lengths, unsigned n, bool allowEmpty)
+            {
+                std::memset(_counts, 0, sizeof(_counts));
+                std::memset(_fast, 0, sizeof(_fast));
+                for (unsigned i = 0; i < n; i++)
+                    _counts[lengths[i]]++;
+                _counts[0] = 0;
+
+                unsigned maxLen = 0;
+                for (unsigned len = 1; len <= 15; len++)
+                    if (_counts[len])
+                        maxLen = len;
+                if (maxLen == 0)
+                    return allowEmpty;
+
+                int left = 1;
+                for (unsigned len = 1; len <= 15; len++)
+                {
+                    left <<= 1;
+                    left -= _counts[len];
+                    if (left < 0)
+                        return false;
+                }
+                if (left > 0 && maxLen != 1)
+                    return false;
+
+                uint16_t offsets[16];
+                uint16_t nextCode[16];
+                offsets[1] = 0;
+                nextCode[1] = 0;
+                for (unsigned len = 1; len < 15; len++)
+                {
+                    offsets[len + 1] = offsets[len] + _counts[len];
+                    nextCode[len + 1] = static_cast<uint16_t>((nextCode[len] + _counts[len]) << 1);
+                }
+
+                for (unsigned sym = 0; sym < n; sym++)
+                {
+                    unsigned len = lengths[sym];
+                    if (len == 0)
+                        continue;
+                    _symbols[offsets[len]++] = static_cast<uint16_t>(sym);
+
+                    unsigned code = nextCode[len]++;
+                    if (len > FAST_BITS)
+                        continue;
+                    unsigned reversed = 0;
+                    for (unsigned b = 0; b < len; b++)
+                        reversed |= ((code >> b) & 1) << (len - 1 - b);
+                    for (unsigned k = reversed; k < (1u << FAST_BITS); k += 1u << len)
+                        _fast[k] = static_cast<uint16_t>((sym << 4) | len);
+                }
+                return true;
+            }
+
+            int decode(BitReader &br) const
+            {
+                br.need(15);
+                uint16_t entry = _fast[br.peek(FAST_BITS)];
+                if (entry != 0)
+                {
+                    br.consume(entry & 15);
+                    return entry >> 4;
+                }
+
+                uint32_t bits = br.peek(15);
+                int code = 0, first = 0, index = 0;
+                for (unsigned len = 1; len <= 15; len++)
+                {
+                    code |= (bits >> (len - 1)) & 1;
+                    int count = _counts[len];
+                    if (code - count < first)
+                    {
+                        br.consume(len);
+                        return _symbols[index + (code - first)];
+                    }
+                    index += count;
+                    first += count;
+                    first <<= 1;
+                    code <<= 1;
+                }
+                return -1;
+            }
+
+        private:
+            uint16_t _fast[1u << FAST_BITS];
+            uint16_t _counts[16];
+            uint16_t _symbols[288];
+        };
+
+        struct BlockTables
+        {
+            Huffman literals;
+            Huffman distances;
+        };
+
+        bool readDynamicTables(BitReader &br, BlockTables &tables)
+        {
+            unsigned hlit = br.bits(5) + 257;
+            unsigned hdist = br.bits(5) + 1;
+            unsigned hclen = br.bits(4) + 4;
+            if (hlit > 286 || hdist > 30)
+                return false;
+
+            uint8_t codeLengthLengths[19] = {};
+            for (unsigned i = 0; i < hclen; i++)
+                codeLengthLengths[CODE_LENGTH_ORDER[i]] = static_cast<uint8_t>(br.bits(3));
+
+            Huffman codeLengths;
+            if (!codeLengths.build(codeLengthLengths, 19, false))
+                return false;
+
+            uint8_t lengths[286 + 30] = {};
+            unsigned index = 0;
+            while (index < hlit + hdist)
+            {
+                int sym = codeLengths.decode(br);
+                if (sym < 0)
+                    return false;
+                if (sym < 16)
+                {
+                    lengths[index++] = static_cast<uint8_t>(sym);
+                    continue;
+                }
+
+                uint8_t value = 0;
+                unsigned repeat;
+                if (sym == 16)
+                {
+                    if (index == 0)
+                        return false;
+                    value = lengths[index - 1];
+                    repeat = 3 + br.bits(2);
+                }
+                else if (sym == 17)
+                {
+                    repeat = 3 + br.bits(3);
+                }
+                else
+                {
+                    repeat = 11 + br.bits(7);
+                }
+                if (index + repeat > hlit + hdist)
+                    return false;
+                while (repeat--)
+                    lengths[index++] = value;
+            }
+
+            if (lengths[256] == 0)
+                return false;
+
+            return tables.literals.build(lengths, hlit, false) &&
+                   tables.distances.build(lengths + hlit, hdist, true);
+        }
+
+        const BlockTables &fixedTables()
+        {
+            static const BlockTables tables = []
+            {
+                BlockTables t;
+                uint8_t lengths[288 + 30];
+                std::fill(lengths, lengths + 144, 8);
+                std::fill(lengths + 144, lengths + 256, 9);
+                std::fill(lengths + 256, lengths + 280, 7);
+                std::fill(lengths + 280, lengths + 288, 8);
+                std::fill(lengths + 288, lengths + 318, 5);
+                t.literals.build(lengths, 288, false);
+                t.distances.build(lengths + 288, 30, false);
+                return t;
+            }();
+            return tables;
+        }
+
+        class ChunkDecoder
+        {
+        public:
+            ChunkDecoder(const uint8_t *data, size_t endByte, bool speculative, size_t limit)
+                : _data(data), _endBit(static_cast<uint64_t>(endByte) * 8), _endByte(endByte),
+                  _speculative(speculative), _limit(limit) {}
+
+            std::vector<uint16_t> output;
+
+            // Decodes blocks starting at `startBit` until a block boundary equals
+            // `stopBit`, or until the final block when `stopBit == NO_STOP`.
+            bool decode(uint64_t startBit, uint64_t stopBit, uint64_t &endBit)
+            {
+                BitReader br(_data, _endByte, startBit);
+                for (;;)
+                {
+                    uint64_t pos = br.tell();
+                    if (pos == stopBit)
+                    {
+                        endBit = pos;
+                        return true;
+                    }
+                    if (pos > stopBit)
+                        return false;
+
+                    bool final = false;
+                    if (!decodeBlock(br, final))
+                        return false;
+
+                    if (final)
+                    {
+                        endBit = br.tell();
+                        return stopBit == NO_STOP;
+                    }
+                }
+            }
+
+            bool decodeBlock(BitReader &br, bool &final)
+            {
+                final = br.bits(1) != 0;
+                unsigned type = br.bits(2);
+
+                bool ok;
+                if (type == 0)
+                {
+                    ok = decodeStored(br);
+                }
+                else if (type == 1)
+                {
+                    ok = decodeHuffman(br, fixedTables());
+                }
+                else if (type == 2)
+                {
+                    if (!readDynamicTables(br, _tables))
+                        return false;
+                    ok = decodeHuffman(br, _tables);
+                }
+                else
+                {
+                    return false;
+                }
+                return ok && br.tell() <= _endBit && output.size() <= _limit;
+            }
+
+        private:
+            bool decodeStored(BitReader &br)
+            {
+                br.alignToByte();
+                uint32_t len = br.bits(16);
+                uint32_t nlen = br.bits(16);
+                if (len != (~nlen & 0xffff))
+                    return false;
+
+                uint64_t bytePos = br.tell() / 8;
+                if (bytePos + len > _endByte || output.size() + len > _limit)
+                    return false;
+
+                const uint8_t *src = _data + bytePos;
+                output.insert(output.end(), src, src + len);
+                br.seek((bytePos + len) * 8);
+                return true;
+            }
+
+            bool decodeHuffman(BitReader &br, const BlockTables &tables)
+            {
+                for (;;)
+                {
+                    if (br.tell() > _endBit)
+                        return false;
+
+                    int sym = tables.literals.decode(br);
+                    if (sym < 0)
+                        return false;
+                    if (sym < 256)
+                    {
+                        output.push_back(static_cast<uint16_t>(sym));
+                        continue;
+                    }
+                    if (sym == 256)
+                        return true;
+
+                    sym -= 257;
+                    if (sym >= 29)
+                        return false;
+                    size_t length = LENGTH_BASE[sym] + br.bits(LENGTH_EXTRA[sym]);
+
+                    int distSym = tables.distances.decode(br);
+                    if (distSym < 0 || distSym >= 30)
+                        return false;
+                    size_t distance = DIST_BASE[distSym] + br.bits(DIST_EXTRA[distSym]);
+
+                    size_t produced = output.size();
+                    size_t reachable = _speculative ? produced + WINDOW_SIZE : produced;
+                    if (distance > reachable || produced + length > _limit)
+                        return false;
+
+                    output.resize(produced + length);
+                    uint16_t *out = output.data();
+                    for (size_t k = 0; k < length; k++)
+                    {
+                        int64_t src = static_cast<int64_t>(produced + k) - static_cast<int64_t>(distance);
+                        out[produced + k] = src >= 0
+                                                ? out[src]
+                                                : static_cast<uint16_t>(PLACEHOLDER_BASE + WINDOW_SIZE + src);
+                    }
+                }
+            }
+
+            const uint8_t *_data;
+            uint64_t _endBit;
+            size_t _endByte;
+            bool _speculative;
+            size_t _limit;
+            BlockTables _tables;
+        };
+
+        // Returns the offset of the deflate data after a gzip member header.
+        std::optional<size_t> skipGzipHeader(const uint8_t *data, size_t size)
+        {
+            if (size < 18 || data[0] != 0x1f || data[1] != 0x8b || data[2] != 8)
+                return std::nullopt;
+
+            uint8_t flags = data[3];
+            size_t pos = 10;
+            if (flags & 0x04) // FEXTRA
+            {
+                if (pos + 2 > size)
+                    return std::nullopt;
+                pos += 2 + (data[pos] | (data[pos + 1] << 8));
+            }
+            for (uint8_t flag : {0x08, 0x10}) // FNAME, FCOMMENT
+            {
+                if (!(flags & flag))
+                    continue;
+                while (pos < size && data[pos] != 0)
+                    pos++;
+                pos++;
+            }
+            if (flags & 0x02) // FHCRC
+                pos += 2;
+
+            if (pos + 8 > size)
+                return std::nullopt;
+            return pos;
+        }
+
+        uint32_t readBits(const uint8_t *data, size_t size, uint64_t bitPos, unsigned n)
+        {
+            uint32_t value = 0;
+            for (unsigned i = 0; i < n; i++)
+            {
+                uint64_t bit = bitPos + i;
+                size_t byte = static_cast<size_t>(bit >> 3);
+                if (byte >= size)
+                    break;
+                value |= static_cast<uint32_t>((data[byte] >> (bit & 7)) & 1) << i;
+            }
+            return value;
+        }
+
+        // Scans [fromBit, toBit) for the start of a non-final dynamic block that
+        // decodes cleanly and is followed by another plausible block header.
+        std::optional<uint64_t> findBlockBoundary(const uint8_t *data, size_t endByte, uint64_t fromBit, uint64_t toBit)
+        {
+            ChunkDecoder trial(data, endByte, true, SIZE_MAX);
+            for (uint64_t bit = fromBit; bit < toBit; bit++)
+            {
+                // BFINAL = 0, BTYPE = 10, HLIT <= 29, HDIST <= 29
+                uint32_t head = readBits(data, endByte, bit, 13);
+                if ((head & 7) != 4 || ((head >> 3) & 31) > 29 || ((head >> 8) & 31) > 29)
+                    continue;
+
+                trial.output.clear();
+                BitReader br(data, endByte, bit);
+                bool final = false;
+                if (!trial.decodeBlock(br, final) || trial.output.empty())
+                    continue;
+
+                uint32_t next = readBits(data, endByte, br.tell(), 3);
+                if ((next >> 1) == 3)
+                    continue;
+                return bit;
+            }
+            return std::nullopt;
+        }
+
+        // Replaces placeholders using the window that precedes the chunk.
+        void resolve(const uint16_t *symbols, size_t count, const uint8_t *window, uint8_t *out)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                uint16_t sym = symbols[i];
+                out[i] = sym < PLACEHOLDER_BASE ? static_cast<uint8_t>(sym) : window[sym - PLACEHOLDER_BASE];
+            }
+        }
+
+        uint32_t readLE32(const uint8_t *p)
+        {
+            return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                   (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        }
+
+        // Runs fn(0) .. fn(count - 1) on the shared WorkerPool. gunzip() itself
+        // usually runs as a pool job, which must not block on queued jobs, so the
+        // caller claims and runs every task that hasn't started yet and only waits
+        // for the ones already running on another worker.
+        template <typename Fn>
+        void forEachChunk(size_t count, JobPriority priority, const Fn &fn)
+        {
+            struct State
+            {
+                std::unique_ptr<std::atomic<bool>[]> claimed;
+                std::mutex mutex;
+                std::condition_variable done;
+                size_t running = 0;
+                std::exception_ptr error;
+            };
+            auto state = std::make_shared<State>();
+            state->claimed = std::make_unique<std::atomic<bool>[]>(count);
+
+            // Only dereferenced after a successful claim, which can't happen once the caller has claimed everything
+            auto run = [state, fnPtr = &fn](size_t i)
+            {
+                if (state->claimed[i].exchange(true))
+                    return;
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->running++;
+                }
+                std::exception_ptr error;
+                try
+                {
+                    (*fnPtr)(i);
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (error && !state->error)
+                    state->error = error;
+                if (--state->running == 0)
+                    state->done.notify_all();
+            };
+
+            for (size_t i = 1; i < count; i++)
+                WorkerPool::shared().submit([run, i]()
+                                            { run(i); },
+                                            priority);
+            for (size_t i = 0; i < count; i++)
+                run(i);
+
+            std::unique_lock<std::mutex> lock(state->mutex);
+            state->done.wait(lock, [&]()
+                             { return state->running == 0; });
+            if (state->error)
+                std::rethrow_exception(state->error);
+        }
+    } // namespace
+
+    std::optional<std::vector<uint8_t>> ParallelInflate::gunzip(const uint8_t *data, size_t size, const Config &config)
+    {
+        auto headerEnd = skipGzipHeader(data, size);
+        if (!headerEnd)
+            return std::nullopt;
+
+        const size_t deflateStart = *headerEnd;
+        const size_t deflateEnd = size - 8;
+        const size_t compressedSize = deflateEnd - deflateStart;
+
+        unsigned threads = config.maxThreads != 0 ? config.maxThreads : WorkerPool::shared().size();
+        size_t chunkCount = std::min<size_t>(std::max(threads, 1u), compressedSize / std::max<size_t>(config.minChunkSize, 1));
+        if (chunkCount < 2)
+            return std::nullopt;
+
+        // Phase 1: find a block boundary inside every chunk but the first
+        const size_t step = compressedSize / chunkCount;
+        std::vector<std::optional<uint64_t>> boundaries(chunkCount - 1);
+        forEachChunk(chunkCount - 1, config.priority, [&](size_t i)
+                     {
+            uint64_t fromBit = static_cast<uint64_t>(deflateStart + (i + 1) * step) * 8;
+            uint64_t toBit = fromBit + static_cast<uint64_t>(step) * 8;
+            boundaries[i] = findBlockBoundary(data, deflateEnd, fromBit, toBit); });
+
+        std::vector<uint64_t> starts = {static_cast<uint64_t>(deflateStart) * 8};
+        for (const auto &bit : boundaries)
+        {
+            if (bit)
+                starts.push_back(*bit);
+        }
+        if (starts.size() < 2)
+            return std::nullopt;
+
+        // Phase 2: decode all chunks concurrently, each must end exactly where the next begins.
+        // Every decoder exists before any task starts, tasks only index into fixed-size vectors
+        const size_t chunks = starts.size();
+        std::vector<std::unique_ptr<ChunkDecoder>> decoders;
+        decoders.reserve(chunks);
+        for (size_t i = 0; i < chunks; i++)
+            decoders.push_back(std::make_unique<ChunkDecoder>(data, deflateEnd, i > 0, config.maxOutputLength));
+        std::vector<uint64_t> endBits(chunks);
+        std::vector<uint8_t> decoded(chunks, 0);
+        forEachChunk(chunks, config.priority, [&](size_t i)
+                     {
+            uint64_t stopBit = i + 1 < chunks ? starts[i + 1] : NO_STOP;
+            decoded[i] = decoders[i]->decode(starts[i], stopBit, endBits[i]); });
+
+        if (std::find(decoded.begin(), decoded.end(), 0) != decoded.end())
+            return std::nullopt;
+
+        // Anything after the final block other than the trailer means multi-member input
+        if ((endBits.back() + 7) / 8 != deflateEnd)
+            return std::nullopt;
+
+        std::vector<size_t> offsets(chunks + 1, 0);
+        for (size_t i = 0; i < chunks; i++)
+            offsets[i + 1] = offsets[i] + decoders[i]->output.size();
+        const size_t total = offsets.back();
+        if (total > config.maxOutputLength || static_cast<uint32_t>(total) != readLE32(data + size - 4))
+            return std::nullopt;
+
+        // Phase 3: propagate windows serially (only the last 32 KiB of each chunk), then resolve in parallel
+        std::vector<std::vector<uint8_t>> windows(chunks, std::vector<uint8_t>(WINDOW_SIZE, 0));
+        for (size_t i = 1; i < chunks; i++)
+        {
+            const auto &prev = decoders[i - 1]->output;
+            const auto &prevWindow = windows[i - 1];
+            auto &window = windows[i];
+
+            size_t tail = std::min(prev.size(), WINDOW_SIZE);
+            size_t carried = WINDOW_SIZE - tail;
+            std::memcpy(window.data(), prevWindow.data() + tail, carried);
+            resolve(prev.data() + prev.size() - tail, tail, prevWindow.data(), window.data() + carried);
+        }
+
+        std::vector<uint8_t> result(total);
+        std::vector<uLong> crcs(chunks);
+        forEachChunk(chunks, config.priority, [&](size_t i)
+                     {
+            const auto &symbols = decoders[i]->output;
+            uint8_t *out = result.data() + offsets[i];
+            resolve(symbols.data(), symbols.size(), windows[i].data(), out);
+            std::vector<uint16_t>().swap(decoders[i]->output);
+            crcs[i] = crc32_z(crc32(0L, Z_NULL, 0), out, offsets[i + 1] - offsets[i]); });
+
+        uLong crc = crcs[0];
+        for (size_t i = 1; i < chunks; i++)
+            crc = crc32_combine(crc, crcs[i], static_cast<z_off_t>(offsets[i + 1] - offsets[i]));
+
+        if (static_cast<uint32_t>(crc) != readLE32(data + size - 8))
+            return std::nullopt;
+
+        return result;
+    }
+
+} // namespace margelo::nitro::rnzlib
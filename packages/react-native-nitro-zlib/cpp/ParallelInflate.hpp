@@ -0,0 +1,44 @@
+#pragma once
+
+#include "WorkerPool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace margelo::nitro::rnzlib
+{
+
+    /**
+     * Experimental speculative parallel decoder for single-member gzip data
+     * (pugz / rapidgzip style).
+     *
+     * The deflate body is cut into chunks. Every chunk but the first scans for a
+     * plausible dynamic Huffman block header, then all chunks are decoded
+     * concurrently on the shared WorkerPool. Back-references reaching before
+     * the start of a chunk are stored as placeholders into the (still unknown)
+     * 32 KiB window and resolved in a second pass once the preceding chunk's
+     * output is known.
+     *
+     * Returns std::nullopt whenever speculation does not pay off or fails (input
+     * too small, no boundary found, chunks don't line up, multi-member input,
+     * CRC/size mismatch). Callers are expected to fall back to serial inflate.
+     */
+    class ParallelInflate
+    {
+    public:
+        struct Config
+        {
+            // Minimum amount of compressed bytes handled by one worker
+            size_t minChunkSize = 1 << 20;
+            // 0 = the shared WorkerPool's thread count
+            unsigned maxThreads = 0;
+            size_t maxOutputLength = SIZE_MAX;
+            // Queue the chunk jobs run on
+            JobPriority priority = JobPriority::Normal;
+        };
+
+        static std::optional<std::vector<uint8_t>> gunzip(const uint8_t *data, size_t size, const Config &config);
+    };
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,151 @@
+#include "WorkerPool.hpp"
+#include <algorithm>
+
+#if defined(__APPLE__)
+#include <pthread.h>
+#include <sys/qos.h>
+#elif defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace margelo::nitro::rnzlib
+{
+    namespace
+    {
+        // Set on background workers, so codecs can find their pool
+        thread_local WorkerPool *backgroundPool = nullptr;
+
+        void lowerThreadPriority()
+        {
+#if defined(__APPLE__)
+            pthread_set_qos_class_self_np(QOS_CLASS_UTILITY, 0);
+#elif defined(__linux__)
+            // Per-thread nice on Linux and Android, 10 = THREAD_PRIORITY_BACKGROUND
+            setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 10);
+#endif
+        }
+    } // namespace
+
+    WorkerPool &WorkerPool::shared()
+    {
+        // Leaked on purpose, joining workers during static destruction can deadlock
+        static WorkerPool *pool = new WorkerPool(std::clamp(std::thread::hardware_concurrency(), 1u, 4u));
+        return *pool;
+    }
+
+    WorkerPool::WorkerPool(unsigned threads)
+    {
+        threads = std::max(threads, 1u);
+        _threads.reserve(threads);
+        for (unsigned i = 0; i < threads; i++)
+            _threads.emplace_back([this]()
+                                  { workerLoop(); });
+        _backgroundThread = std::thread([this]()
+                                        { backgroundLoop(); });
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _wake.notify_all();
+        _backgroundWake.notify_all();
+        _interactiveIdle.notify_all();
+        for (auto &thread : _threads)
+            thread.join();
+        _backgroundThread.join();
+    }
+
+    bool WorkerPool::onBackgroundWorker()
+    {
+        return backgroundPool != nullptr;
+    }
+
+    void WorkerPool::yieldToInteractive()
+    {
+        WorkerPool *pool = backgroundPool;
+        if (pool == nullptr)
+            return;
+        std::unique_lock<std::mutex> lock(pool->_mutex);
+        pool->_interactiveIdle.wait(lock, [pool]()
+                                    { return pool->_interactivePending == 0 || pool->_stopping; });
+    }
+
+    void WorkerPool::enqueue(std::function<void()> job, JobPriority priority)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            switch (priority)
+            {
+            case JobPriority::Interactive:
+                _interactive.push_back(std::move(job));
+                _interactivePending++;
+                break;
+            case JobPriority::Normal:
+                _normal.push_back(std::move(job));
+                break;
+            case JobPriority::Background:
+                _background.push_back(std::move(job));
+                break;
+            }
+        }
+        if (priority == JobPriority::Background)
+            _backgroundWake.notify_one();
+        else
+            _wake.notify_one();
+    }
+
+    void WorkerPool::workerLoop()
+    {
+        while (true)
+        {
+            std::function<void()> job;
+            bool interactive = false;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wake.wait(lock, [this]()
+                           { return _stopping || !_interactive.empty() || !_normal.empty(); });
+                interactive = !_interactive.empty();
+                auto &queue = interactive ? _interactive : _normal;
+                if (queue.empty())
+                    return; // stopping and drained
+                job = std::move(queue.front());
+                queue.pop_front();
+            }
+            // packaged_task stores exceptions in its future, nothing escapes here
+            job();
+
+            if (interactive)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (--_interactivePending == 0)
+                    _interactiveIdle.notify_all();
+            }
+        }
+    }
+
+    void WorkerPool::backgroundLoop()
+    {
+        lowerThreadPriority();
+        backgroundPool = this;
+        while (true)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _backgroundWake.wait(lock, [this]()
+                                     { return _stopping || !_background.empty(); });
+                if (_background.empty())
+                    return;
+                job = std::move(_background.front());
+                _background.pop_front();
+            }
+            job();
+        }
+    }
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace margelo::nitro::rnzlib
+{
+
+    // Matches ZlibPriority in JS
+    enum class JobPriority : uint8_t
+    {
+        Interactive = 0,
+        Normal = 1,
+        Background = 2
+    };
+
+    /**
+     * Fixed set of native worker threads for CPU-bound batch work.
+     *
+     * Interactive and normal jobs share the foreground threads, interactive
+     * ones first; within a priority jobs run in submission order. Background
+     * jobs get their own thread at a lower OS priority, and codecs running
+     * there pause between steps while interactive work is pending.
+     *
+     * A job must never block on another job of the same pool; coordinate
+     * from a thread outside the pool instead.
+     */
+    class WorkerPool
+    {
+    public:
+        // Process-wide pool, sized to the device but never more than 4 foreground threads
+        static WorkerPool &shared();
+
+        explicit WorkerPool(unsigned threads);
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool &) = delete;
+        WorkerPool &operator=(const WorkerPool &) = delete;
+
+        template <typename Fn>
+        std::future<std::invoke_result_t<Fn>> submit(Fn &&fn, JobPriority priority = JobPriority::Normal)
+        {
+            using R = std::invoke_result_t<Fn>;
+            auto task = std::make_shared<std::packaged_task<R()>>(std::forward<Fn>(fn));
+            auto future = task->get_future();
+            enqueue([task]()
+                    { (*task)(); },
+                    priority);
+            return future;
+        }
+
+        unsigned size() const { return static_cast<unsigned>(_threads.size()); }
+
+        // True on a background worker thread of any pool
+        static bool onBackgroundWorker();
+
+        // On a background worker: waits until no interactive job is queued or running
+        static void yieldToInteractive();
+
+    private:
+        void enqueue(std::function<void()> job, JobPriority priority);
+        void workerLoop();
+        void backgroundLoop();
+
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::condition_variable _backgroundWake;
+        std::condition_variable _interactiveIdle;
+        std::deque<std::function<void()>> _interactive;
+        std::deque<std::function<void()>> _normal;
+        std::deque<std::function<void()>> _background;
+        // Interactive jobs queued or running
+        unsigned _interactivePending = 0;
+        std::vector<std::thread> _threads;
+        std::thread _backgroundThread;
+        bool _stopping = false;
+    };
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,879 @@
+#pragma once
+
+#include <zlib.h>
+#include <NitroModules/ArrayBuffer.hpp>
+#include "ZlibOptions.hpp"
+#include "ZlibTrace.hpp"
+#include "Base64.hpp"
+#include "HybridAbortToken.hpp"
+#include "WorkerPool.hpp"
+#include "CompressibilityProbe.hpp"
+#include "FormatSniffer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Largest input slice handed to zlib per refill (avail_in is a uInt). Can be
+// lowered to test window boundaries without gigabytes of input.
+#ifndef RNZLIB_INPUT_WINDOW
+#define RNZLIB_INPUT_WINDOW UINT_MAX
+#endif
+
+namespace margelo::nitro::rnzlib
+{
+
+    enum class Direction
+    {
+        Deflate,
+        Inflate
+    };
+
+    enum class Format
+    {
+        Raw,
+        Zlib,
+        Gzip,
+        Auto // inflate only: zlib or gzip header
+    };
+
+    /**
+     * ZlibOptions resolved once per call, on the JS thread, so the codec loop
+     * never looks at optionals and async work never touches JS-owned memory.
+     */
+    struct CodecParams
+    {
+        int level = Z_DEFAULT_COMPRESSION;
+        int windowBits = 15;
+        int memLevel = 8;
+        int strategy = Z_DEFAULT_STRATEGY;
+        int finishFlush = Z_FINISH;
+        size_t chunkSize = 16 * 1024;
+        size_t maxOutputLength = SIZE_MAX;
+        // Deflate only: probe the input and lower the level for incompressible data
+        bool adaptive = false;
+        // Streams only: ZlibMemoryProfile.LOW
+        bool lowMemory = false;
+        std::vector<uint8_t> dictionary;
+        // ZlibOptions.signal / deadlineMs, polled between codec steps
+        std::shared_ptr<const std::atomic<bool>> abortFlag;
+        std::optional<std::chrono::steady_clock::time_point> deadline;
+        // Async one-shot methods: the WorkerPool queue they run on
+        JobPriority priority = JobPriority::Normal;
+        // ZlibOptions.onProgress and its throttle, see ProgressThrottle
+        std::function<void(double, double)> onProgress;
+        std::chrono::steady_clock::duration progressInterval = std::chrono::milliseconds(100);
+        uint64_t progressBytes = 0;
+
+        bool cancellable() const { return abortFlag != nullptr || deadline.has_value(); }
+
+        void throwIfCancelled() const
+        {
+            if (abortFlag && abortFlag->load(std::memory_order_relaxed))
+                throw std::runtime_error("Operation aborted");
+            if (deadline.has_value() && std::chrono::steady_clock::now() >= *deadline)
+                throw std::runtime_error("Deadline exceeded");
+        }
+
+        static CodecParams from(const std::optional<ZlibOptions> &options)
+        {
+            CodecParams params;
+            if (!options.has_value())
+            {
+                return params;
+            }
+            if (options->level.has_value())
+                params.level = static_cast<int>(options->level.value());
+            if (options->windowBits.has_value())
+                params.windowBits = static_cast<int>(options->windowBits.value());
+            if (options->memLevel.has_value())
+                params.memLevel = static_cast<int>(options->memLevel.value());
+            if (options->strategy.has_value())
+                params.strategy = static_cast<int>(options->strategy.value());
+            // One-shot calls used to pass `flush` to every zlib call, keep honoring it
+            if (options->finishFlush.has_value())
+                params.finishFlush = static_cast<int>(options->finishFlush.value());
+            else if (options->flush.has_value())
+                params.finishFlush = static_cast<int>(options->flush.value());
+            if (options->chunkSize.has_value() && options->chunkSize.value() > 0)
+                params.chunkSize = static_cast<size_t>(options->chunkSize.value());
+            if (options->maxOutputLength.has_value())
+                params.maxOutputLength = static_cast<size_t>(options->maxOutputLength.value());
+            if (options->adaptive.has_value())
+                params.adaptive = options->adaptive.value();
+            if (options->memoryProfile.has_value())
+                params.lowMemory = static_cast<int>(options->memoryProfile.value()) == 1;
+            if (options->dictionary.has_value() && options->dictionary.value())
+            {
+                const auto &dictionary = options->dictionary.value();
+                const uint8_t *ptr = dictionary->data();
+                params.dictionary.assign(ptr, ptr + dictionary->size());
+            }
+            if (options->signal.has_value() && options->signal.value())
+            {
+                auto token = std::dynamic_pointer_cast<HybridAbortToken>(options->signal.value());
+                if (!token)
+                    throw std::runtime_error("signal must come from createAbortToken()");
+                params.abortFlag = token->flag();
+            }
+            if (options->priority.has_value())
+            {
+                double priority = options->priority.value();
+                if (priority != 0 && priority != 1 && priority != 2)
+                    throw std::runtime_error("priority must be a ZlibPriority value");
+                params.priority = static_cast<JobPriority>(static_cast<int>(priority));
+            }
+            if (options->onProgress.has_value() && options->onProgress.value())
+                params.onProgress = options->onProgress.value();
+            if (options->progressIntervalMs.has_value())
+            {
+                auto ms = std::chrono::duration<double, std::milli>(std::max(0.0, options->progressIntervalMs.value()));
+                params.progressInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(ms);
+            }
+            if (options->progressIntervalBytes.has_value())
+                params.progressBytes = static_cast<uint64_t>(std::max(0.0, options->progressIntervalBytes.value()));
+            // Counted from the call, so queueing time on a worker counts too
+            if (options->deadlineMs.has_value())
+            {
+                auto ms = std::chrono::duration<double, std::milli>(std::max(0.0, options->deadlineMs.value()));
+                params.deadline = std::chrono::steady_clock::now() +
+                                  std::chrono::duration_cast<std::chrono::steady_clock::duration>(ms);
+            }
+            return params;
+        }
+    };
+
+    // windowBits as zlib's init functions expect them for a framing
+    constexpr int framedWindowBits(Format format, int bits)
+    {
+        switch (format)
+        {
+        case Format::Raw:
+            return -bits;
+        case Format::Gzip:
+            return bits + 16;
+        case Format::Auto:
+            return bits + 32;
+        default:
+            return bits;
+        }
+    }
+
+    // inflateInit2 windowBits for a sniffed format, undecided input is treated as raw
+    constexpr int sniffedWindowBits(DetectedFormat format, int bits = 15)
+    {
+        switch (format)
+        {
+        case DetectedFormat::Gzip:
+            return framedWindowBits(Format::Gzip, bits);
+        case DetectedFormat::Zlib:
+            return framedWindowBits(Format::Zlib, bits);
+        default:
+            return framedWindowBits(Format::Raw, bits);
+        }
+    }
+
+    // Direction/format specific zlib calls, all resolved at compile time
+    template <Direction D, Format F>
+    struct CodecTraits
+    {
+        static_assert(D == Direction::Inflate || F != Format::Auto, "Auto format is only valid for inflate");
+
+        static constexpr int windowBits(int bits)
+        {
+            return framedWindowBits(F, bits);
+        }
+
+        static int init(z_stream *strm, const CodecParams &params)
+        {
+            if constexpr (D == Direction::Deflate)
+            {
+                return deflateInit2(strm, params.level, Z_DEFLATED, windowBits(params.windowBits),
+                                    params.memLevel, params.strategy);
+            }
+            else
+            {
+                return inflateInit2(strm, windowBits(params.windowBits));
+            }
+        }
+
+        // Deflate and raw inflate take the dictionary up front, zlib inflate asks for it (Z_NEED_DICT)
+        static int setDictionary(z_stream *strm, const std::vector<uint8_t> &dictionary)
+        {
+            if constexpr (D == Direction::Deflate)
+            {
+                return deflateSetDictionary(strm, dictionary.data(), static_cast<uInt>(dictionary.size()));
+            }
+            else
+            {
+                return inflateSetDictionary(strm, dictionary.data(), static_cast<uInt>(dictionary.size()));
+            }
+        }
+
+        static constexpr bool dictionaryUpfront = D == Direction::Deflate || F == Format::Raw;
+
+        static int step(z_stream *strm, int flush)
+        {
+            if constexpr (D == Direction::Deflate)
+                return ::deflate(strm, flush);
+            else
+                return ::inflate(strm, flush);
+        }
+
+        static void end(z_stream *strm)
+        {
+            if constexpr (D == Direction::Deflate)
+                deflateEnd(strm);
+            else
+                inflateEnd(strm);
+        }
+
+        static constexpr size_t MAX_INFLATE_GUESS = 64 * 1024 * 1024;
+
+        // First allocation: deflateBound() is exact enough for a single pass, inflate guesses 4x
+        static size_t initialCapacity(z_stream *strm, size_t inputLength, const CodecParams &params)
+        {
+            if constexpr (D == Direction::Deflate)
+                return std::max<size_t>(deflateBound(strm, static_cast<uLong>(inputLength)), params.chunkSize);
+            else
+                return std::max<size_t>(std::min<size_t>(inputLength * 4, MAX_INFLATE_GUESS), params.chunkSize);
+        }
+    };
+
+    // What a finished run consumed and produced, read straight off the z_stream
+    struct CodecSummary
+    {
+        uint64_t bytesIn = 0;
+        uint64_t bytesOut = 0;
+        // adler32 (zlib) or crc32 (gzip) of the uncompressed data, raw streams have none
+        std::optional<uint32_t> checksum;
+        // Set when an adaptive deflate probed the input
+        std::optional<CompressibilityProbe::Decision> adaptive;
+    };
+
+    // Storage for a gzip header parsed by inflate (see inflateGetHeader)
+    struct GzipHeaderCapture
+    {
+        gz_header header{};
+        Bytef name[256] = {};
+        Bytef comment[256] = {};
+
+        // Longer fields are truncated by zlib, the last byte stays 0 as terminator
+        GzipHeaderCapture()
+        {
+            header.name = name;
+            header.name_max = sizeof(name) - 1;
+            header.comment = comment;
+            header.comm_max = sizeof(comment) - 1;
+        }
+
+        bool parsed() const { return header.done == 1; }
+    };
+
+    /**
+     * Rate limit for CodecParams::onProgress. Every call becomes a job on the
+     * JS thread, so the loop only reports once both the time and the byte
+     * interval have passed since the previous report, plus once at the end.
+     */
+    class ProgressThrottle
+    {
+    public:
+        explicit ProgressThrottle(const CodecParams &params)
+            : _params(params), _last(std::chrono::steady_clock::now()) {}
+
+        bool enabled() const { return static_cast<bool>(_params.onProgress); }
+
+        void update(uint64_t bytesIn, uint64_t bytesOut)
+        {
+            if (!enabled() || bytesIn - _lastIn < _params.progressBytes)
+                return;
+            auto now = std::chrono::steady_clock::now();
+            if (now - _last < _params.progressInterval)
+                return;
+            _last = now;
+            report(bytesIn, bytesOut);
+        }
+
+        void finish(uint64_t bytesIn, uint64_t bytesOut)
+        {
+            if (enabled())
+                report(bytesIn, bytesOut);
+        }
+
+    private:
+        void report(uint64_t bytesIn, uint64_t bytesOut)
+        {
+            _lastIn = bytesIn;
+            _params.onProgress(static_cast<double>(bytesIn), static_cast<double>(bytesOut));
+        }
+
+        const CodecParams &_params;
+        std::chrono::steady_clock::time_point _last;
+        uint64_t _lastIn = 0;
+    };
+
+    // Limit policies
+    struct Unlimited
+    {
+        size_t remaining(size_t) const { return SIZE_MAX; }
+    };
+
+    struct MaxOutputLength
+    {
+        size_t max;
+        size_t remaining(size_t produced) const { return produced >= max ? 0 : max - produced; }
+    };
+
+    /**
+     * Output policy that grows one contiguous heap block geometrically and hands
+     * it to the resulting ArrayBuffer as-is (no final copy).
+     */
+    class HeapOutput
+    {
+    public:
+        explicit HeapOutput(size_t chunkSize) : _chunkSize(chunkSize) {}
+        ~HeapOutput() { std::free(_data); }
+
+        HeapOutput(const HeapOutput &) = delete;
+        HeapOutput &operator=(const HeapOutput &) = delete;
+
+        void reserve(size_t capacity)
+        {
+            if (capacity > _capacity)
+                resize(capacity);
+        }
+
+        // Makes more space writable, capped to `limit` more bytes
+        uint8_t *prepare(size_t &available, size_t limit)
+        {
+            if (_size == _capacity)
+            {
+                size_t grow = std::max(_capacity, _chunkSize);
+                resize(_size + std::min(grow, limit));
+            }
+            available = std::min(_capacity - _size, limit);
+            return _data + _size;
+        }
+
+        void commit(size_t n) { _size += n; }
+        // Gives back the last n committed bytes
+        void drop(size_t n) { _size -= std::min(n, _size); }
+        size_t size() const { return _size; }
+
+        std::shared_ptr<ArrayBuffer> release()
+        {
+            // Give back over-allocation (e.g. deflateBound() on compressible data)
+            if (_capacity - _size > _size / 4)
+                resize(_size);
+
+            uint8_t *data = _data;
+            size_t size = _size;
+            _data = nullptr;
+            _size = _capacity = 0;
+            return std::make_shared<NativeArrayBuffer>(data, size, [data]()
+                                                       { std::free(data); });
+        }
+
+    private:
+        void resize(size_t capacity)
+        {
+            void *data = std::realloc(_data, std::max<size_t>(capacity, 1));
+            if (data == nullptr)
+                throw std::bad_alloc();
+            _data = static_cast<uint8_t *>(data);
+            _capacity = capacity;
+        }
+
+        uint8_t *_data = nullptr;
+        size_t _size = 0;
+        size_t _capacity = 0;
+        size_t _chunkSize;
+    };
+
+    /**
+     * The single codec loop behind every one-shot API, sync or async.
+     * Direction and format are template parameters, output growth and output
+     * limits are policy types, so each instantiation is a straight inlined loop.
+     */
+    template <Direction D, Format F, typename Output, typename Limit>
+    class Codec
+    {
+        using Traits = CodecTraits<D, F>;
+
+    public:
+        static CodecSummary run(const uint8_t *input, size_t length, const CodecParams &params, Output &output,
+                                const Limit &limit, GzipHeaderCapture *gzipHeader = nullptr)
+        {
+            // Already aborted or expired: fail before zlib init and the output reservation
+            if (params.cancellable())
+                params.throwIfCancelled();
+
+            z_stream strm;
+            std::memset(&strm, 0, sizeof(strm));
+
+            int ret = Traits::init(&strm, params);
+            if (ret != Z_OK)
+            {
+                throw std::runtime_error(errorMessage("Failed to initialize zlib", ret, &strm));
+            }
+            StreamGuard guard{&strm};
+
+            if constexpr (D == Direction::Inflate && (F == Format::Gzip || F == Format::Auto))
+            {
+                if (gzipHeader != nullptr)
+                    inflateGetHeader(&strm, &gzipHeader->header);
+            }
+
+            if (Traits::dictionaryUpfront && !params.dictionary.empty())
+            {
+                ret = Traits::setDictionary(&strm, params.dictionary);
+                if (ret != Z_OK)
+                    throw std::runtime_error(errorMessage("Failed to set dictionary", ret, &strm));
+            }
+
+            // avail_in/avail_out are uInt: input is fed in windows of at most
+            // UINT_MAX bytes and the totals are counted here, as 64-bit
+            const uint8_t *unfed = input;
+            size_t unfedLength = length;
+            uint64_t produced = 0;
+
+            output.reserve(std::min(Traits::initialCapacity(&strm, length, params), limit.remaining(0)));
+
+            // Background jobs also take bounded steps, and pause while interactive work runs
+            const bool background = WorkerPool::onBackgroundWorker();
+            ProgressThrottle progress(params);
+            const bool bounded = background || params.cancellable() || progress.enabled();
+
+            for (;;)
+            {
+                if (strm.avail_out == 0)
+                {
+                    size_t remaining = limit.remaining(output.size());
+                    if (remaining == 0)
+                        throw std::runtime_error("Output exceeds maxOutputLength");
+
+                    size_t available = 0;
+                    strm.next_out = output.prepare(available, remaining);
+                    // Bounded steps, so an abort, a deadline, interactive work or a progress report is due within a few ms
+                    if (bounded)
+                        available = std::min(available, BOUNDED_STEP);
+                    strm.avail_out = static_cast<uInt>(std::min<size_t>(available, UINT_MAX));
+                }
+                if (strm.avail_in == 0 && unfedLength > 0)
+                {
+                    uInt window = static_cast<uInt>(std::min<size_t>(unfedLength, INPUT_WINDOW));
+                    strm.next_in = const_cast<Bytef *>(unfed);
+                    strm.avail_in = window;
+                    unfed += window;
+                    unfedLength -= window;
+                }
+                if (background)
+                    WorkerPool::yieldToInteractive();
+                if (params.cancellable())
+                    params.throwIfCancelled();
+                progress.update(length - unfedLength - strm.avail_in, produced);
+
+                // The requested flush only applies once the last window is in
+                uInt before = strm.avail_out;
+                ret = Traits::step(&strm, unfedLength > 0 ? Z_NO_FLUSH : params.finishFlush);
+                output.commit(before - strm.avail_out);
+                produced += before - strm.avail_out;
+                ZLIB_TRACE("codec.step", length - unfedLength - strm.avail_in, produced);
+
+                if (ret == Z_STREAM_END)
+                    break;
+
+                if (ret == Z_NEED_DICT)
+                {
+                    if (params.dictionary.empty())
+                        throw std::runtime_error("Missing dictionary");
+                    ret = Traits::setDictionary(&strm, params.dictionary);
+                    if (ret != Z_OK)
+                        throw std::runtime_error(errorMessage("Bad dictionary", ret, &strm));
+                    continue;
+                }
+
+                if (ret == Z_BUF_ERROR)
+                {
+                    // Output space left but no progress: input is exhausted
+                    if (strm.avail_out == 0)
+                        continue;
+                    if (params.finishFlush == Z_FINISH)
+                        throw std::runtime_error("Unexpected end of input");
+                    break;
+                }
+
+                if (ret != Z_OK)
+                    throw std::runtime_error(errorMessage("Processing error", ret, &strm));
+
+                // Partial flushes (e.g. Z_SYNC_FLUSH) end once input is drained
+                if (params.finishFlush != Z_FINISH && unfedLength == 0 && strm.avail_in == 0 && strm.avail_out != 0)
+                    break;
+            }
+
+            CodecSummary summary;
+            summary.bytesIn = length - unfedLength - strm.avail_in;
+            summary.bytesOut = produced;
+            progress.finish(summary.bytesIn, summary.bytesOut);
+            if (F != Format::Raw)
+                summary.checksum = static_cast<uint32_t>(strm.adler);
+            return summary;
+        }
+
+    private:
+        static constexpr size_t BOUNDED_STEP = 64 * 1024;
+        static constexpr size_t INPUT_WINDOW = RNZLIB_INPUT_WINDOW;
+
+        struct StreamGuard
+        {
+            z_stream *strm;
+            ~StreamGuard() { Traits::end(strm); }
+        };
+
+        static std::string errorMessage(const char *what, int ret, const z_stream *strm)
+        {
+            std::string message = std::string(what) + " (" + std::to_string(ret) + ")";
+            if (strm->msg != nullptr)
+                message += ": " + std::string(strm->msg);
+            return message;
+        }
+    };
+
+    /**
+     * Output policy writing into a region the caller owns (e.g. a JS arena).
+     * Once the region is full, output goes to a scratch block and is only
+     * counted, so an overflow can report the size that would have been needed.
+     */
+    class FixedOutput
+    {
+    public:
+        FixedOutput(uint8_t *data, size_t capacity) : _data(data), _capacity(capacity) {}
+
+        void reserve(size_t) {}
+
+        uint8_t *prepare(size_t &available, size_t limit)
+        {
+            if (_size < _capacity)
+            {
+                available = std::min(_capacity - _size, limit);
+                return _data + _size;
+            }
+            if (_scratch == nullptr)
+                _scratch = std::make_unique<uint8_t[]>(SCRATCH_SIZE);
+            available = std::min(SCRATCH_SIZE, limit);
+            return _scratch.get();
+        }
+
+        void commit(size_t n) { _size += n; }
+        size_t size() const { return _size; }
+        bool overflowed() const { return _size > _capacity; }
+
+    private:
+        static constexpr size_t SCRATCH_SIZE = 32 * 1024;
+
+        uint8_t *_data;
+        size_t _capacity;
+        size_t _size = 0;
+        std::unique_ptr<uint8_t[]> _scratch;
+    };
+
+    // Output policy growing a std::string, for results that become JS strings
+    class StringOutput
+    {
+    public:
+        explicit StringOutput(size_t chunkSize) : _chunkSize(chunkSize) {}
+
+        void reserve(size_t capacity)
+        {
+            if (capacity > _data.size())
+                _data.resize(capacity);
+        }
+
+        // Grows like HeapOutput; std::string zero-fills, which is cheap next to inflate
+        uint8_t *prepare(size_t &available, size_t limit)
+        {
+            if (_size == _data.size())
+                _data.resize(_size + std::min(std::max(_data.size(), _chunkSize), limit));
+            available = std::min(_data.size() - _size, limit);
+            return reinterpret_cast<uint8_t *>(_data.data()) + _size;
+        }
+
+        void commit(size_t n) { _size += n; }
+        size_t size() const { return _size; }
+
+        std::string release()
+        {
+            _data.resize(_size);
+            _size = 0;
+            return std::move(_data);
+        }
+
+    private:
+        std::string _data;
+        size_t _size = 0;
+        size_t _chunkSize;
+    };
+
+    /**
+     * Output policy encoding to base64 as the codec produces bytes: zlib
+     * writes into a scratch block and each block is encoded on commit, so
+     * the binary output is never held in full.
+     */
+    class Base64Output
+    {
+    public:
+        void reserve(size_t capacity) { _encoder.reserve(capacity); }
+
+        uint8_t *prepare(size_t &available, size_t limit)
+        {
+            if (_scratch == nullptr)
+                _scratch = std::make_unique<uint8_t[]>(SCRATCH_SIZE);
+            available = std::min(SCRATCH_SIZE, limit);
+            return _scratch.get();
+        }
+
+        void commit(size_t n)
+        {
+            _encoder.append(_scratch.get(), n);
+            _size += n;
+        }
+
+        // Binary bytes, so maxOutputLength keeps its meaning
+        size_t size() const { return _size; }
+        std::string release() { return _encoder.finish(); }
+
+    private:
+        // A multiple of 3 keeps the encoder from carrying bytes between blocks
+        static constexpr size_t SCRATCH_SIZE = 3 * 16 * 1024;
+
+        Base64Encoder _encoder;
+        std::unique_ptr<uint8_t[]> _scratch;
+        size_t _size = 0;
+    };
+
+    /**
+     * Output policy writing into fixed-size segments, each its own heap
+     * block, for outputs too large to get as one contiguous allocation.
+     * Filled segments are never moved or copied, only the last is trimmed.
+     */
+    class SegmentedOutput
+    {
+    public:
+        static constexpr size_t DEFAULT_SEGMENT_SIZE = 1024 * 1024;
+        static constexpr size_t MIN_SEGMENT_SIZE = 1024;
+
+        explicit SegmentedOutput(size_t segmentSize) : _segmentSize(segmentSize) {}
+        ~SegmentedOutput()
+        {
+            for (uint8_t *segment : _segments)
+                std::free(segment);
+        }
+
+        SegmentedOutput(const SegmentedOutput &) = delete;
+        SegmentedOutput &operator=(const SegmentedOutput &) = delete;
+
+        static size_t segmentSize(std::optional<double> requested)
+        {
+            if (!requested.has_value())
+                return DEFAULT_SEGMENT_SIZE;
+            if (!(requested.value() >= MIN_SEGMENT_SIZE))
+                throw std::runtime_error("segmentSize must be at least " + std::to_string(MIN_SEGMENT_SIZE) + " bytes");
+            return static_cast<size_t>(requested.value());
+        }
+
+        // Segments are allocated as they fill, a size hint would not help
+        void reserve(size_t) {}
+
+        uint8_t *prepare(size_t &available, size_t limit)
+        {
+            if (_segments.empty() || _used == _segmentSize)
+            {
+                // Slot first, so a failed push_back can't leak the block
+                _segments.push_back(nullptr);
+                _segments.back() = static_cast<uint8_t *>(std::malloc(_segmentSize));
+                if (_segments.back() == nullptr)
+                {
+                    _segments.pop_back();
+                    throw std::bad_alloc();
+                }
+                _used = 0;
+            }
+            available = std::min(_segmentSize - _used, limit);
+            return _segments.back() + _used;
+        }
+
+        void commit(size_t n)
+        {
+            _used += n;
+            _size += n;
+        }
+        size_t size() const { return _size; }
+
+        // Every segment is full except the last, an empty output has none
+        std::vector<std::shared_ptr<ArrayBuffer>> release()
+        {
+            if (!_segments.empty() && _used == 0)
+            {
+                std::free(_segments.back());
+                _segments.pop_back();
+                _used = _segmentSize;
+            }
+            // Shrinking in place does not need a second block
+            if (!_segments.empty() && _segmentSize - _used > _used / 4)
+            {
+                void *trimmed = std::realloc(_segments.back(), _used);
+                if (trimmed != nullptr)
+                    _segments.back() = static_cast<uint8_t *>(trimmed);
+            }
+
+            std::vector<std::shared_ptr<ArrayBuffer>> result;
+            result.reserve(_segments.size());
+            for (size_t i = 0; i < _segments.size(); i++)
+            {
+                uint8_t *data = _segments[i];
+                size_t size = i + 1 == _segments.size() ? _used : _segmentSize;
+                result.push_back(std::make_shared<NativeArrayBuffer>(data, size, [data]()
+                                                                     { std::free(data); }));
+                // Owned by the ArrayBuffer from here on
+                _segments[i] = nullptr;
+            }
+            _segments.clear();
+            _size = _used = 0;
+            return result;
+        }
+
+    private:
+        std::vector<uint8_t *> _segments;
+        size_t _segmentSize;
+        // Bytes written to the last segment
+        size_t _used = 0;
+        size_t _size = 0;
+    };
+
+    // Runs the codec into any output policy, applying maxOutputLength and the adaptive probe
+    template <Direction D, Format F, typename Output>
+    CodecSummary runCodecTo(const uint8_t *input, size_t length, const CodecParams &params, Output &output,
+                            GzipHeaderCapture *gzipHeader = nullptr)
+    {
+        auto execute = [&](const CodecParams &p)
+        {
+            if (p.maxOutputLength == SIZE_MAX)
+                return Codec<D, F, Output, Unlimited>::run(input, length, p, output, Unlimited{}, gzipHeader);
+            return Codec<D, F, Output, MaxOutputLength>::run(input, length, p, output, MaxOutputLength{p.maxOutputLength}, gzipHeader);
+        };
+
+        if (D == Direction::Deflate && params.adaptive)
+        {
+            auto decision = CompressibilityProbe::decide(input, length, params.level);
+            CodecSummary result;
+            if (decision.level != params.level)
+            {
+                CodecParams adjusted = params;
+                adjusted.level = decision.level;
+                result = execute(adjusted);
+            }
+            else
+            {
+                result = execute(params);
+            }
+            result.adaptive = decision;
+            return result;
+        }
+        return execute(params);
+    }
+
+    // Runs the codec over a byte range and returns a freshly allocated ArrayBuffer
+    template <Direction D, Format F>
+    std::shared_ptr<ArrayBuffer> runCodec(const uint8_t *input, size_t length, const CodecParams &params,
+                                          CodecSummary *summary = nullptr, GzipHeaderCapture *gzipHeader = nullptr)
+    {
+        HeapOutput output(params.chunkSize);
+        CodecSummary result = runCodecTo<D, F>(input, length, params, output, gzipHeader);
+        if (summary != nullptr)
+            *summary = result;
+        return output.release();
+    }
+
+    // Runs the codec and returns the output as a string (UTF-8 for the string APIs)
+    template <Direction D, Format F>
+    std::string runCodecToString(const uint8_t *input, size_t length, const CodecParams &params)
+    {
+        StringOutput output(params.chunkSize);
+        runCodecTo<D, F>(input, length, params, output);
+        return output.release();
+    }
+
+    // Runs the codec and returns the output base64 encoded
+    template <Direction D, Format F>
+    std::string runCodecToBase64(const uint8_t *input, size_t length, const CodecParams &params)
+    {
+        Base64Output output;
+        runCodecTo<D, F>(input, length, params, output);
+        return output.release();
+    }
+
+    // Runs the codec and returns the output as segments of segmentSize bytes
+    template <Direction D, Format F>
+    std::vector<std::shared_ptr<ArrayBuffer>> runCodecToSegments(const uint8_t *input, size_t length,
+                                                                 const CodecParams &params, size_t segmentSize)
+    {
+        SegmentedOutput output(segmentSize);
+        runCodecTo<D, F>(input, length, params, output);
+        return output.release();
+    }
+
+    /**
+     * Runs the codec into destination[0, capacity) and returns the bytes
+     * written. Throws when the output doesn't fit, with the size it needs.
+     */
+    template <Direction D, Format F>
+    size_t runCodecInto(const uint8_t *input, size_t length, const CodecParams &params, uint8_t *destination, size_t capacity)
+    {
+        FixedOutput output(destination, capacity);
+        runCodecTo<D, F>(input, length, params, output);
+        if (output.overflowed())
+            throw std::runtime_error("Destination too small: " + std::to_string(output.size()) + " bytes needed, " +
+                                     std::to_string(capacity) + " available");
+        return output.size();
+    }
+
+    // One-shot inflate of gzip, zlib or raw deflate, picked from the header bytes in a single pass
+    inline std::shared_ptr<ArrayBuffer> runUnzip(const uint8_t *input, size_t length, const CodecParams &params,
+                                                 CodecSummary *summary = nullptr, GzipHeaderCapture *gzipHeader = nullptr)
+    {
+        switch (sniffFormat(input, length))
+        {
+        case DetectedFormat::Gzip:
+            return runCodec<Direction::Inflate, Format::Gzip>(input, length, params, summary, gzipHeader);
+        case DetectedFormat::Zlib:
+            return runCodec<Direction::Inflate, Format::Zlib>(input, length, params, summary);
+        default:
+            return runCodec<Direction::Inflate, Format::Raw>(input, length, params, summary);
+        }
+    }
+
+    // runUnzip into segments of segmentSize bytes
+    inline std::vector<std::shared_ptr<ArrayBuffer>> runUnzipToSegments(const uint8_t *input, size_t length,
+                                                                        const CodecParams &params, size_t segmentSize)
+    {
+        switch (sniffFormat(input, length))
+        {
+        case DetectedFormat::Gzip:
+            return runCodecToSegments<Direction::Inflate, Format::Gzip>(input, length, params, segmentSize);
+        case DetectedFormat::Zlib:
+            return runCodecToSegments<Direction::Inflate, Format::Zlib>(input, length, params, segmentSize);
+        default:
+            return runCodecToSegments<Direction::Inflate, Format::Raw>(input, length, params, segmentSize);
+        }
+    }
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,252 @@
+#include "ZlibMetrics.hpp"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+namespace margelo::nitro::rnzlib
+{
+
+    std::atomic<bool> ZlibMetrics::_enabled{false};
+
+    namespace
+    {
+        constexpr size_t OP_COUNT = static_cast<size_t>(MetricOp::COUNT);
+
+        /**
+         * Log-linear latency buckets in nanoseconds (HDR-style): every power of
+         * two is split into 8 linear sub-buckets, so any recorded value is off by
+         * at most 12.5%. Values above ~9 minutes land in the last bucket.
+         */
+        constexpr unsigned SUB_BITS = 3;
+        constexpr uint64_t SUB_COUNT = 1 << SUB_BITS;
+        constexpr unsigned MAX_EXPONENT = 39;
+        constexpr size_t BUCKET_COUNT = (MAX_EXPONENT - SUB_BITS + 2) * SUB_COUNT;
+
+        size_t bucketIndex(uint64_t value)
+        {
+            if (value < SUB_COUNT)
+                return static_cast<size_t>(value);
+            unsigned exponent = 63 - static_cast<unsigned>(__builtin_clzll(value));
+            if (exponent > MAX_EXPONENT)
+                return BUCKET_COUNT - 1;
+            uint64_t sub = (value >> (exponent - SUB_BITS)) & (SUB_COUNT - 1);
+            return static_cast<size_t>((exponent - SUB_BITS + 1) * SUB_COUNT + sub);
+        }
+
+        // Midpoint of a bucket, used as the reported value for percentiles
+        double bucketValue(size_t index)
+        {
+            if (index < SUB_COUNT)
+                return static_cast<double>(index);
+            unsigned exponent = static_cast<unsigned>(index / SUB_COUNT) + SUB_BITS - 1;
+            uint64_t sub = index % SUB_COUNT;
+            double width = static_cast<double>(uint64_t(1) << (exponent - SUB_BITS));
+            return static_cast<double>((SUB_COUNT + sub) << (exponent - SUB_BITS)) + width / 2;
+        }
+
+        struct OpStats
+        {
+            std::atomic<uint64_t> calls{0};
+            std::atomic<uint64_t> errors{0};
+            std::atomic<uint64_t> bytesIn{0};
+            std::atomic<uint64_t> bytesOut{0};
+            std::atomic<uint64_t> totalNs{0};
+            std::atomic<uint64_t> maxNs{0};
+            std::atomic<uint64_t> buckets[BUCKET_COUNT] = {};
+
+            void reset()
+            {
+                calls.store(0, std::memory_order_relaxed);
+                errors.store(0, std::memory_order_relaxed);
+                bytesIn.store(0, std::memory_order_relaxed);
+                bytesOut.store(0, std::memory_order_relaxed);
+                totalNs.store(0, std::memory_order_relaxed);
+                maxNs.store(0, std::memory_order_relaxed);
+                for (auto &bucket : buckets)
+                    bucket.store(0, std::memory_order_relaxed);
+            }
+        };
+
+        struct Shard
+        {
+            OpStats ops[OP_COUNT];
+        };
+
+        // Shards are never freed: a thread that exits hands its shard (and its counts) to the next thread
+        class ShardRegistry
+        {
+        public:
+            static ShardRegistry &instance()
+            {
+                // Leaked on purpose, thread_local leases may be released after static destruction
+                static ShardRegistry *registry = new ShardRegistry();
+                return *registry;
+            }
+
+            Shard *acquire()
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_free.empty())
+                {
+                    Shard *shard = _free.back();
+                    _free.pop_back();
+                    return shard;
+                }
+                _shards.push_back(std::make_unique<Shard>());
+                return _shards.back().get();
+            }
+
+            void release(Shard *shard)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _free.push_back(shard);
+            }
+
+            template <typename Fn>
+            void forEach(Fn fn)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (const auto &shard : _shards)
+                    fn(*shard);
+            }
+
+        private:
+            std::mutex _mutex;
+            std::vector<std::unique_ptr<Shard>> _shards;
+            std::vector<Shard *> _free;
+        };
+
+        struct ShardLease
+        {
+            Shard *shard = nullptr;
+
+            ~ShardLease()
+            {
+                if (shard != nullptr)
+                    ShardRegistry::instance().release(shard);
+            }
+        };
+
+        Shard &localShard()
+        {
+            thread_local ShardLease lease;
+            if (lease.shard == nullptr)
+                lease.shard = ShardRegistry::instance().acquire();
+            return *lease.shard;
+        }
+
+        double nsToMs(double ns)
+        {
+            return ns / 1e6;
+        }
+    } // namespace
+
+    const char *metricName(MetricOp op)
+    {
+        static const char *const names[OP_COUNT] = {
+            "inflateSync", "inflateRawSync", "compressSync", "deflateSync", "deflateRawSync", "gzipSync", "gunzipSync",
+            "unzipSync", "inflate", "inflateRaw", "compress", "deflate", "deflateRaw", "gzip", "gunzip", "unzip",
+            "gunzipParallel", "inflateInto", "gunzipInto", "deflateInto",
+            "deflateString", "gzipString", "inflateToString", "gunzipToString",
+            "deflateToBase64", "gzipToBase64", "inflateFromBase64", "gunzipFromBase64",
+            "storePut", "storeGet", "deflateToHandle", "gzipToHandle", "inflateToHandle", "gunzipToHandle",
+            "unzipToHandle", "inflateSegmented", "gunzipSegmented", "unzipSegmented",
+            "streamWrite", "streamFlush", "streamEnd"};
+        return names[static_cast<size_t>(op)];
+    }
+
+    void ZlibMetrics::setEnabled(bool enabled)
+    {
+        _enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    void ZlibMetrics::record(MetricOp op, uint64_t bytesIn, uint64_t bytesOut, uint64_t latencyNs, bool failed)
+    {
+        OpStats &stats = localShard().ops[static_cast<size_t>(op)];
+        stats.calls.fetch_add(1, std::memory_order_relaxed);
+        if (failed)
+            stats.errors.fetch_add(1, std::memory_order_relaxed);
+        stats.bytesIn.fetch_add(bytesIn, std::memory_order_relaxed);
+        stats.bytesOut.fetch_add(bytesOut, std::memory_order_relaxed);
+        stats.totalNs.fetch_add(latencyNs, std::memory_order_relaxed);
+        stats.buckets[bucketIndex(latencyNs)].fetch_add(1, std::memory_order_relaxed);
+
+        // Only the owning thread writes maxNs (reset() aside), no CAS loop needed
+        if (latencyNs > stats.maxNs.load(std::memory_order_relaxed))
+            stats.maxNs.store(latencyNs, std::memory_order_relaxed);
+    }
+
+    std::vector<OperationMetrics> ZlibMetrics::snapshot()
+    {
+        struct Merged
+        {
+            uint64_t calls = 0, errors = 0, bytesIn = 0, bytesOut = 0, totalNs = 0, maxNs = 0;
+            std::vector<uint64_t> buckets = std::vector<uint64_t>(BUCKET_COUNT, 0);
+        };
+        std::vector<Merged> merged(OP_COUNT);
+
+        ShardRegistry::instance().forEach([&merged](const Shard &shard)
+                                          {
+            for (size_t op = 0; op < OP_COUNT; op++)
+            {
+                const OpStats &stats = shard.ops[op];
+                Merged &m = merged[op];
+                m.calls += stats.calls.load(std::memory_order_relaxed);
+                m.errors += stats.errors.load(std::memory_order_relaxed);
+                m.bytesIn += stats.bytesIn.load(std::memory_order_relaxed);
+                m.bytesOut += stats.bytesOut.load(std::memory_order_relaxed);
+                m.totalNs += stats.totalNs.load(std::memory_order_relaxed);
+                m.maxNs = std::max(m.maxNs, stats.maxNs.load(std::memory_order_relaxed));
+                for (size_t i = 0; i < BUCKET_COUNT; i++)
+                    m.buckets[i] += stats.buckets[i].load(std::memory_order_relaxed);
+            } });
+
+        std::vector<OperationMetrics> result;
+        for (size_t op = 0; op < OP_COUNT; op++)
+        {
+            const Merged &m = merged[op];
+            if (m.calls == 0)
+                continue;
+
+            uint64_t recorded = 0;
+            for (uint64_t count : m.buckets)
+                recorded += count;
+            auto percentile = [&m, recorded](double p) -> double
+            {
+                uint64_t rank = static_cast<uint64_t>(p * static_cast<double>(recorded) + 0.5);
+                uint64_t seen = 0;
+                for (size_t i = 0; i < BUCKET_COUNT; i++)
+                {
+                    seen += m.buckets[i];
+                    if (seen >= rank && seen > 0)
+                        return std::min(bucketValue(i), static_cast<double>(m.maxNs));
+                }
+                return static_cast<double>(m.maxNs);
+            };
+
+            result.emplace_back(metricName(static_cast<MetricOp>(op)),
+                                static_cast<double>(m.calls),
+                                static_cast<double>(m.errors),
+                                static_cast<double>(m.bytesIn),
+                                static_cast<double>(m.bytesOut),
+                                m.bytesIn > 0 ? static_cast<double>(m.bytesOut) / static_cast<double>(m.bytesIn) : 0.0,
+                                nsToMs(static_cast<double>(m.totalNs)),
+                                nsToMs(static_cast<double>(m.totalNs) / static_cast<double>(m.calls)),
+                                nsToMs(percentile(0.50)),
+                                nsToMs(percentile(0.90)),
+                                nsToMs(percentile(0.99)),
+                                nsToMs(static_cast<double>(m.maxNs)));
+        }
+        return result;
+    }
+
+    void ZlibMetrics::reset()
+    {
+        // Samples recorded concurrently with a reset may be partially cleared
+        ShardRegistry::instance().forEach([](Shard &shard)
+                                          {
+            for (auto &stats : shard.ops)
+                stats.reset(); });
+    }
+
+} // namespace margelo::nitro::rnzlib
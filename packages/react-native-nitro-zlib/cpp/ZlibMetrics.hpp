@@ -0,0 +1,143 @@
+#pragma once
+
+#include "OperationMetrics.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+/**
+ * RNZLIB_METRICS=0 compiles the metrics subsystem out entirely. When compiled
+ * in, recording is still off until ZlibMetrics::setEnabled(true); a disabled
+ * MetricsScope costs one relaxed atomic load.
+ */
+#ifndef RNZLIB_METRICS
+#define RNZLIB_METRICS 1
+#endif
+
+namespace margelo::nitro::rnzlib
+{
+
+    // Every API method that is measured, names match the JS methods
+    enum class MetricOp : uint8_t
+    {
+        inflateSync,
+        inflateRawSync,
+        compressSync,
+        deflateSync,
+        deflateRawSync,
+        gzipSync,
+        gunzipSync,
+        unzipSync,
+        inflate,
+        inflateRaw,
+        compress,
+        deflate,
+        deflateRaw,
+        gzip,
+        gunzip,
+        unzip,
+        gunzipParallel,
+        inflateInto,
+        gunzipInto,
+        deflateInto,
+        deflateString,
+        gzipString,
+        inflateToString,
+        gunzipToString,
+        deflateToBase64,
+        gzipToBase64,
+        inflateFromBase64,
+        gunzipFromBase64,
+        storePut,
+        storeGet,
+        deflateToHandle,
+        gzipToHandle,
+        inflateToHandle,
+        gunzipToHandle,
+        unzipToHandle,
+        inflateSegmented,
+        gunzipSegmented,
+        unzipSegmented,
+        streamWrite,
+        streamFlush,
+        streamEnd,
+        COUNT
+    };
+
+    const char *metricName(MetricOp op);
+
+    /**
+     * Per-operation call counts, byte totals and latency histograms.
+     *
+     * Each thread records into its own shard (claimed on first use, handed back
+     * to a free list when the thread exits), so recording is a handful of
+     * uncontended relaxed atomic adds. Readers merge all shards.
+     */
+    class ZlibMetrics
+    {
+    public:
+        static bool enabled()
+        {
+#if RNZLIB_METRICS
+            return _enabled.load(std::memory_order_relaxed);
+#else
+            return false;
+#endif
+        }
+
+        static void setEnabled(bool enabled);
+        static void record(MetricOp op, uint64_t bytesIn, uint64_t bytesOut, uint64_t latencyNs, bool failed);
+        static std::vector<OperationMetrics> snapshot();
+        static void reset();
+
+    private:
+        static std::atomic<bool> _enabled;
+    };
+
+    /**
+     * Times the enclosing block and records it on destruction. Leaving the
+     * block through an exception counts as an error.
+     */
+    class MetricsScope
+    {
+    public:
+        MetricsScope(MetricOp op, size_t bytesIn) : _active(ZlibMetrics::enabled())
+        {
+            if (_active)
+            {
+                _op = op;
+                _bytesIn = bytesIn;
+                _exceptions = std::uncaught_exceptions();
+                _start = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~MetricsScope()
+        {
+            if (_active)
+            {
+                auto elapsed = std::chrono::steady_clock::now() - _start;
+                ZlibMetrics::record(_op, _bytesIn, _bytesOut,
+                                    static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+                                    std::uncaught_exceptions() > _exceptions);
+            }
+        }
+
+        MetricsScope(const MetricsScope &) = delete;
+        MetricsScope &operator=(const MetricsScope &) = delete;
+
+        void setBytesOut(size_t bytesOut) { _bytesOut = bytesOut; }
+
+    private:
+        bool _active;
+        MetricOp _op = MetricOp::COUNT;
+        int _exceptions = 0;
+        size_t _bytesIn = 0;
+        size_t _bytesOut = 0;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+} // namespace margelo::nitro::rnzlib
@@ -6,31 +6,61 @@
 #include <optional>
 #include <zlib.h>
 #include "HybridZlibSpec.hpp"
+#include "ZlibCodec.hpp"
+#include "ZlibResultInfo.hpp"
+#include "InputView.hpp"
 
 namespace margelo::nitro::rnzlib
 {
 
     using DeleteFn = std::function<void()>;
 
+    // Owns a copy of the input range so async work never touches JS-owned memory
     class ZlibProcessor
     {
     public:
-        explicit ZlibProcessor(const std::shared_ptr<ArrayBuffer> &data);
-        ~ZlibProcessor();
+        explicit ZlibProcessor(const InputView &input);
 
         // Prevent copying
         ZlibProcessor(const ZlibProcessor &) = delete;
         ZlibProcessor &operator=(const ZlibProcessor &) = delete;
 
-        std::shared_ptr<ArrayBuffer> process(
-            int (*zlibFunc)(z_stream *, int),
-            std::function<int(z_stream *, int)> zlibInit,
-            int windowBits,
-            const std::optional<ZlibOptions> &options);
+        template <Direction D, Format F>
+        std::shared_ptr<ArrayBuffer> process(const CodecParams &params)
+        {
+            return runCodec<D, F>(inputData.data(), inputData.size(), params);
+        }
+
+        template <Direction D, Format F>
+        ZlibResult processWithInfo(const CodecParams &params)
+        {
+            return runCodecWithInfo<D, F>(inputData.data(), inputData.size(), params);
+        }
+
+        // Gzip, zlib or raw deflate, detected from the header bytes
+        std::shared_ptr<ArrayBuffer> unzip(const CodecParams &params)
+        {
+            return runUnzip(inputData.data(), inputData.size(), params);
+        }
+
+        template <Direction D, Format F>
+        std::vector<std::shared_ptr<ArrayBuffer>> processSegmented(const CodecParams &params, size_t segmentSize)
+        {
+            return runCodecToSegments<D, F>(inputData.data(), inputData.size(), params, segmentSize);
+        }
+
+        std::vector<std::shared_ptr<ArrayBuffer>> unzipSegmented(const CodecParams &params, size_t segmentSize)
+        {
+            return runUnzipToSegments(inputData.data(), inputData.size(), params, segmentSize);
+        }
+
+        size_t size() const { return inputData.size(); }
+
+        // Speculative parallel gunzip, falls back to a serial gunzip if speculation fails
+        std::shared_ptr<ArrayBuffer> gunzipParallel(const CodecParams &params);
 
     private:
         std::vector<uint8_t> inputData;
-        z_stream strm;
     };
 
-} // namespace margelo::nitro::rnzlib
\ No newline at end of file
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "ZlibCodec.hpp"
+#include "ZlibResult.hpp"
+#include <chrono>
+#include <ctime>
+
+namespace margelo::nitro::rnzlib
+{
+
+    // CPU time consumed by the calling thread, in nanoseconds
+    inline uint64_t threadCpuTimeNs()
+    {
+        timespec ts{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+    }
+
+    /**
+     * runCodec() plus the ZlibInfo for *WithInfo methods. Everything is read off
+     * the finished z_stream (totals, adler/crc, parsed gzip header) or the
+     * clocks around the run, there is no extra pass over the data.
+     */
+    template <Direction D, Format F>
+    ZlibResult runCodecWithInfo(const uint8_t *input, size_t length, const CodecParams &params)
+    {
+        constexpr bool readsGzipHeader = D == Direction::Inflate && (F == Format::Gzip || F == Format::Auto);
+
+        CodecSummary summary;
+        GzipHeaderCapture header;
+
+        auto wallStart = std::chrono::steady_clock::now();
+        uint64_t cpuStart = threadCpuTimeNs();
+        auto buffer = runCodec<D, F>(input, length, params, &summary, readsGzipHeader ? &header : nullptr);
+        uint64_t cpuEnd = threadCpuTimeNs();
+        auto wallEnd = std::chrono::steady_clock::now();
+
+        std::optional<GzipHeader> gzipHeader;
+        if (readsGzipHeader && header.parsed())
+        {
+            gzipHeader = GzipHeader(header.header.text != 0,
+                                    static_cast<double>(header.header.time),
+                                    static_cast<double>(header.header.os),
+                                    header.name[0] != 0 ? std::optional<std::string>(reinterpret_cast<const char *>(header.name)) : std::nullopt,
+                                    header.comment[0] != 0 ? std::optional<std::string>(reinterpret_cast<const char *>(header.comment)) : std::nullopt);
+        }
+
+        std::optional<AdaptiveDecision> adaptive;
+        if (summary.adaptive.has_value())
+        {
+            const auto &decision = summary.adaptive.value();
+            adaptive = AdaptiveDecision(decision.level, decision.entropy, decision.trialRatio);
+        }
+
+        ZlibInfo info(std::chrono::duration<double, std::milli>(wallEnd - wallStart).count(),
+                      static_cast<double>(cpuEnd - cpuStart) / 1e6,
+                      static_cast<double>(summary.bytesIn),
+                      static_cast<double>(summary.bytesOut),
+                      summary.bytesIn > 0 ? static_cast<double>(summary.bytesOut) / static_cast<double>(summary.bytesIn) : 0.0,
+                      summary.checksum.has_value() ? std::optional<double>(summary.checksum.value()) : std::nullopt,
+                      gzipHeader,
+                      adaptive);
+        return ZlibResult(buffer, info);
+    }
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <NitroModules/NitroLogger.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Compile-time gated logging for the zlib module.
+ *
+ * RNZLIB_LOG_LEVEL selects the lowest level that is compiled in:
+ *   0 = debug, 1 = info, 2 = warning, 3 = error, 4 = off
+ * Anything below it expands to nothing, arguments are never evaluated.
+ * Defaults to debug in debug builds and error in release (NDEBUG) builds.
+ *
+ * RNZLIB_TRACE=1 enables ZLIB_TRACE(), a high-frequency tracer for hot loops
+ * that records into a lock-free in-memory ring instead of the system log.
+ */
+
+#ifndef RNZLIB_LOG_LEVEL
+#ifdef NDEBUG
+#define RNZLIB_LOG_LEVEL 3
+#else
+#define RNZLIB_LOG_LEVEL 0
+#endif
+#endif
+
+#ifndef RNZLIB_TRACE
+#define RNZLIB_TRACE 0
+#endif
+
+#define RNZLIB_LOG(level, tag, ...) ::margelo::nitro::Logger::log(::margelo::nitro::LogLevel::level, tag, __VA_ARGS__)
+
+#if RNZLIB_LOG_LEVEL <= 0
+#define ZLIB_LOG_DEBUG(tag, ...) RNZLIB_LOG(Debug, tag, __VA_ARGS__)
+#else
+#define ZLIB_LOG_DEBUG(tag, ...) ((void)0)
+#endif
+
+#if RNZLIB_LOG_LEVEL <= 1
+#define ZLIB_LOG_INFO(tag, ...) RNZLIB_LOG(Info, tag, __VA_ARGS__)
+#else
+#define ZLIB_LOG_INFO(tag, ...) ((void)0)
+#endif
+
+#if RNZLIB_LOG_LEVEL <= 2
+#define ZLIB_LOG_WARNING(tag, ...) RNZLIB_LOG(Warning, tag, __VA_ARGS__)
+#else
+#define ZLIB_LOG_WARNING(tag, ...) ((void)0)
+#endif
+
+#if RNZLIB_LOG_LEVEL <= 3
+#define ZLIB_LOG_ERROR(tag, ...) RNZLIB_LOG(Error, tag, __VA_ARGS__)
+#else
+#define ZLIB_LOG_ERROR(tag, ...) ((void)0)
+#endif
+
+#if RNZLIB_TRACE
+#define ZLIB_TRACE(event, a, b) ::margelo::nitro::rnzlib::TraceRing::instance().record(event, static_cast<uint64_t>(a), static_cast<uint64_t>(b))
+#else
+#define ZLIB_TRACE(event, a, b) ((void)0)
+#endif
+
+namespace margelo::nitro::rnzlib
+{
+
+    struct TraceRecord
+    {
+        uint64_t sequence;
+        uint64_t timestampNs;
+        const char *event; // always a string literal
+        uint64_t a;
+        uint64_t b;
+    };
+
+    /**
+     * Fixed-size multi-producer ring of trace records. Writers claim a slot with
+     * one fetch_add and publish it through a per-slot sequence (seqlock), so
+     * recording never blocks and never allocates; old records are overwritten.
+     */
+    class TraceRing
+    {
+    public:
+        static constexpr size_t CAPACITY = 4096; // power of two
+
+        static TraceRing &instance()
+        {
+            static TraceRing ring;
+            return ring;
+        }
+
+        void record(const char *event, uint64_t a, uint64_t b) noexcept
+        {
+            uint64_t sequence = _head.fetch_add(1, std::memory_order_relaxed);
+            Slot &slot = _slots[sequence & (CAPACITY - 1)];
+
+            slot.version.store(sequence * 2 + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.timestampNs.store(now(), std::memory_order_relaxed);
+            slot.event.store(event, std::memory_order_relaxed);
+            slot.a.store(a, std::memory_order_relaxed);
+            slot.b.store(b, std::memory_order_relaxed);
+            slot.version.store(sequence * 2 + 2, std::memory_order_release);
+        }
+
+        // Consistent copy of the records still in the ring, oldest first
+        std::vector<TraceRecord> snapshot() const
+        {
+            uint64_t head = _head.load(std::memory_order_acquire);
+            uint64_t first = head > CAPACITY ? head - CAPACITY : 0;
+
+            std::vector<TraceRecord> records;
+            records.reserve(static_cast<size_t>(head - first));
+            for (uint64_t sequence = first; sequence < head; sequence++)
+            {
+                const Slot &slot = _slots[sequence & (CAPACITY - 1)];
+                uint64_t before = slot.version.load(std::memory_order_acquire);
+                if (before != sequence * 2 + 2)
+                    continue; // in flight or already overwritten
+
+                TraceRecord record{sequence,
+                                   slot.timestampNs.load(std::memory_order_relaxed),
+                                   slot.event.load(std::memory_order_relaxed),
+                                   slot.a.load(std::memory_order_relaxed),
+                                   slot.b.load(std::memory_order_relaxed)};
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.version.load(std::memory_order_relaxed) == before)
+                    records.push_back(record);
+            }
+            return records;
+        }
+
+        // Writes the current ring contents to the system log (not for hot paths)
+        void dump() const
+        {
+            for (const auto &record : snapshot())
+            {
+                RNZLIB_LOG(Info, "ZlibTrace", "#%llu t=%lluns %s a=%llu b=%llu",
+                           static_cast<unsigned long long>(record.sequence),
+                           static_cast<unsigned long long>(record.timestampNs),
+                           record.event,
+                           static_cast<unsigned long long>(record.a),
+                           static_cast<unsigned long long>(record.b));
+            }
+        }
+
+    private:
+        struct Slot
+        {
+            std::atomic<uint64_t> version{0};
+            std::atomic<uint64_t> timestampNs{0};
+            std::atomic<const char *> event{nullptr};
+            std::atomic<uint64_t> a{0};
+            std::atomic<uint64_t> b{0};
+        };
+
+        static uint64_t now() noexcept
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                             std::chrono::steady_clock::now().time_since_epoch())
+                                             .count());
+        }
+
+        std::atomic<uint64_t> _head{0};
+        Slot _slots[CAPACITY];
+    };
+
+} // namespace margelo::nitro::rnzlib
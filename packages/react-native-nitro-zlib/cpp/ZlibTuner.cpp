@@ -0,0 +1,176 @@
+#include "ZlibTuner.hpp"
+#include "ZlibCodec.hpp"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+
+namespace margelo::nitro::rnzlib
+{
+
+    namespace
+    {
+        // Each candidate compresses the sample set this many times, the fastest pass counts
+        constexpr int ROUNDS = 3;
+
+        struct Candidate
+        {
+            int level;
+            int windowBits;
+            int memLevel;
+            int strategy;
+            double ratio = 0;
+            double throughputMBps = 0;
+            double memoryBytes = 0;
+        };
+
+        std::vector<Candidate> candidateGrid()
+        {
+            std::vector<Candidate> grid;
+            for (int strategy : {Z_DEFAULT_STRATEGY, Z_FILTERED})
+                for (int level : {1, 3, 6, 9})
+                    for (int windowBits : {10, 12, 15})
+                        for (int memLevel : {5, 8, 9})
+                            grid.push_back({level, windowBits, memLevel, strategy});
+
+            // RLE and Huffman-only ignore the level and never look back further than one byte
+            for (int strategy : {Z_RLE, Z_HUFFMAN_ONLY})
+                for (int memLevel : {5, 8, 9})
+                    grid.push_back({6, 9, memLevel, strategy});
+            return grid;
+        }
+
+        void evaluate(Candidate &candidate, const std::vector<std::vector<uint8_t>> &samples)
+        {
+            CodecParams params;
+            params.level = candidate.level;
+            params.windowBits = candidate.windowBits;
+            params.memLevel = candidate.memLevel;
+            params.strategy = candidate.strategy;
+
+            size_t bytesIn = 0;
+            size_t bytesOut = 0;
+            double bestSeconds = std::numeric_limits<double>::max();
+            for (int round = 0; round < ROUNDS; round++)
+            {
+                size_t produced = 0;
+                auto start = std::chrono::steady_clock::now();
+                for (const auto &sample : samples)
+                    produced += runCodec<Direction::Deflate, Format::Zlib>(sample.data(), sample.size(), params)->size();
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+                bestSeconds = std::min(bestSeconds, elapsed.count());
+                bytesOut = produced;
+            }
+            for (const auto &sample : samples)
+                bytesIn += sample.size();
+
+            candidate.ratio = static_cast<double>(bytesOut) / static_cast<double>(bytesIn);
+            candidate.throughputMBps = static_cast<double>(bytesIn) / (1024.0 * 1024.0) / std::max(bestSeconds, 1e-9);
+            candidate.memoryBytes = static_cast<double>((1 << (candidate.windowBits + 2)) + (1 << (candidate.memLevel + 9)));
+        }
+
+        // Lower ratio, higher throughput and lower memory are better
+        bool dominates(const Candidate &a, const Candidate &b)
+        {
+            bool noWorse = a.ratio <= b.ratio && a.throughputMBps >= b.throughputMBps && a.memoryBytes <= b.memoryBytes;
+            bool better = a.ratio < b.ratio || a.throughputMBps > b.throughputMBps || a.memoryBytes < b.memoryBytes;
+            return noWorse && better;
+        }
+
+        std::vector<Candidate> paretoFrontier(const std::vector<Candidate> &candidates)
+        {
+            std::vector<Candidate> frontier;
+            for (const auto &candidate : candidates)
+            {
+                bool dominated = std::any_of(candidates.begin(), candidates.end(), [&candidate](const Candidate &other)
+                                             { return dominates(other, candidate); });
+                if (!dominated)
+                    frontier.push_back(candidate);
+            }
+            std::sort(frontier.begin(), frontier.end(), [](const Candidate &a, const Candidate &b)
+                      { return a.ratio < b.ratio; });
+            return frontier;
+        }
+
+        /**
+         * Frontier points that meet the hard limits are scored on ratio and
+         * throughput, both normalized over those points. If nothing meets the
+         * limits the whole frontier is scored instead.
+         */
+        const Candidate &pick(const std::vector<Candidate> &frontier, const TuneObjective &objective)
+        {
+            double ratioWeight = std::clamp(objective.ratioWeight.value_or(0.5), 0.0, 1.0);
+            double minThroughput = objective.minThroughputMBps.value_or(0);
+            double maxMemory = objective.maxMemoryBytes.value_or(std::numeric_limits<double>::max());
+
+            std::vector<const Candidate *> eligible;
+            for (const auto &candidate : frontier)
+                if (candidate.throughputMBps >= minThroughput && candidate.memoryBytes <= maxMemory)
+                    eligible.push_back(&candidate);
+            if (eligible.empty())
+                for (const auto &candidate : frontier)
+                    eligible.push_back(&candidate);
+
+            auto [minRatio, maxRatio] = std::minmax_element(eligible.begin(), eligible.end(), [](const Candidate *a, const Candidate *b)
+                                                            { return a->ratio < b->ratio; });
+            auto [minSpeed, maxSpeed] = std::minmax_element(eligible.begin(), eligible.end(), [](const Candidate *a, const Candidate *b)
+                                                            { return a->throughputMBps < b->throughputMBps; });
+            double ratioSpan = std::max((*maxRatio)->ratio - (*minRatio)->ratio, 1e-12);
+            double speedSpan = std::max((*maxSpeed)->throughputMBps - (*minSpeed)->throughputMBps, 1e-12);
+
+            const Candidate *best = nullptr;
+            double bestScore = -1;
+            for (const Candidate *candidate : eligible)
+            {
+                double score = ratioWeight * ((*maxRatio)->ratio - candidate->ratio) / ratioSpan +
+                               (1 - ratioWeight) * (candidate->throughputMBps - (*minSpeed)->throughputMBps) / speedSpan;
+                if (best == nullptr || score > bestScore || (score == bestScore && candidate->memoryBytes < best->memoryBytes))
+                {
+                    best = candidate;
+                    bestScore = score;
+                }
+            }
+            return *best;
+        }
+
+        TuneCandidate toTuneCandidate(const Candidate &candidate)
+        {
+            return TuneCandidate(candidate.level, candidate.windowBits, candidate.memLevel, candidate.strategy,
+                                 candidate.ratio, candidate.throughputMBps, candidate.memoryBytes);
+        }
+    } // namespace
+
+    TuneResult ZlibTuner::tune(const std::vector<std::vector<uint8_t>> &samples, const TuneObjective &objective)
+    {
+        bool hasData = std::any_of(samples.begin(), samples.end(), [](const std::vector<uint8_t> &sample)
+                                   { return !sample.empty(); });
+        if (!hasData)
+        {
+            throw std::runtime_error("tune() needs at least one non-empty sample");
+        }
+
+        // One candidate at a time, so each timing is single-threaded and the
+        // worker pool stays free for the app's own jobs
+        std::vector<Candidate> candidates = candidateGrid();
+        for (auto &candidate : candidates)
+            evaluate(candidate, samples);
+
+        std::vector<Candidate> frontier = paretoFrontier(candidates);
+        const Candidate &best = pick(frontier, objective);
+
+        std::vector<TuneCandidate> result;
+        result.reserve(frontier.size());
+        for (const auto &candidate : frontier)
+            result.push_back(toTuneCandidate(candidate));
+
+        ZlibOptions recommended;
+        recommended.windowBits = static_cast<double>(best.windowBits);
+        recommended.level = static_cast<double>(best.level);
+        recommended.memLevel = static_cast<double>(best.memLevel);
+        recommended.strategy = static_cast<double>(best.strategy);
+
+        return TuneResult(std::move(result), toTuneCandidate(best), recommended, static_cast<double>(candidates.size()));
+    }
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "TuneObjective.hpp"
+#include "TuneResult.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace margelo::nitro::rnzlib
+{
+
+    /**
+     * Picks deflate parameters from data instead of defaults.
+     *
+     * Every candidate of a fixed level/windowBits/memLevel/strategy grid
+     * compresses the whole sample set, one candidate after another on the
+     * calling thread so throughput is measured without contention. Candidates
+     * are scored on output ratio, compression throughput and deflate memory
+     * (zlib's documented (1 << (windowBits + 2)) + (1 << (memLevel + 9))).
+     * The Pareto frontier over those three is returned together with the
+     * frontier point that best matches the objective.
+     *
+     * Blocks until all candidates finished, call it off the JS thread.
+     */
+    class ZlibTuner
+    {
+    public:
+        static TuneResult tune(const std::vector<std::vector<uint8_t>> &samples, const TuneObjective &objective);
+    };
+
+} // namespace margelo::nitro::rnzlib
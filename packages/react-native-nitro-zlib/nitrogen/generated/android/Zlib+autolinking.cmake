@@ -27,6 +27,11 @@ target_sources(
   # Autolinking Setup
   ../nitrogen/generated/android/ZlibOnLoad.cpp
   # Shared Nitrogen C++ sources
+  ../nitrogen/generated/shared/c++/HybridPerMessageDeflateSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridContentDecoderSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridCompressedStoreSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridCompressedBufferSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridAbortTokenSpec.cpp
   ../nitrogen/generated/shared/c++/HybridZlibStreamSpec.cpp
   ../nitrogen/generated/shared/c++/HybridZlibSpec.cpp
   # Android-specific Nitrogen C++ sources
@@ -0,0 +1,76 @@
+///
+/// AdaptiveDecision.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2024 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+
+
+namespace margelo::nitro::rnzlib {
+
+  /**
+   * A struct which can be represented as a JavaScript object (AdaptiveDecision).
+   */
+  struct AdaptiveDecision {
+  public:
+    double level     SWIFT_PRIVATE;
+    double entropy     SWIFT_PRIVATE;
+    double trialRatio     SWIFT_PRIVATE;
+
+  public:
+    explicit AdaptiveDecision(double level, double entropy, double trialRatio): level(level), entropy(entropy), trialRatio(trialRatio) {}
+  };
+
+} // namespace margelo::nitro::rnzlib
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::rnzlib;
+
+  // C++ AdaptiveDecision <> JS AdaptiveDecision (object)
+  template <>
+  struct JSIConverter<AdaptiveDecision> {
+    static inline AdaptiveDecision fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return AdaptiveDecision(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "level")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "entropy")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "trialRatio"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const AdaptiveDecision& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "level", JSIConverter<double>::toJSI(runtime, arg.level));
+      obj.setProperty(runtime, "entropy", JSIConverter<double>::toJSI(runtime, arg.entropy));
+      obj.setProperty(runtime, "trialRatio", JSIConverter<double>::toJSI(runtime, arg.trialRatio));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "level"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "entropy"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "trialRatio"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,76 @@
+///
+/// CompressedStoreOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2024 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+
+namespace margelo::nitro::rnzlib {
+
+  /**
+   * A struct which can be represented as a JavaScript object (CompressedStoreOptions).
+   */
+  struct CompressedStoreOptions {
+  public:
+    std::optional<double> maxCompressedBytes     SWIFT_PRIVATE;
+    std::optional<double> maxHotBytes     SWIFT_PRIVATE;
+    std::optional<double> level     SWIFT_PRIVATE;
+
+  public:
+    explicit CompressedStoreOptions(std::optional<double> maxCompressedBytes, std::optional<double> maxHotBytes, std::optional<double> level): maxCompressedBytes(maxCompressedBytes), maxHotBytes(maxHotBytes), level(level) {}
+  };
+
+} // namespace margelo::nitro::rnzlib
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::rnzlib;
+
+  // C++ CompressedStoreOptions <> JS CompressedStoreOptions (object)
+  template <>
+  struct JSIConverter<CompressedStoreOptions> {
+    static inline CompressedStoreOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return CompressedStoreOptions(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxCompressedBytes")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxHotBytes")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "level"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const CompressedStoreOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "maxCompressedBytes", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxCompressedBytes));
+      obj.setProperty(runtime, "maxHotBytes", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxHotBytes));
+      obj.setProperty(runtime, "level", JSIConverter<std::optional<double>>::toJSI(runtime, arg.level));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxCompressedBytes"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxHotBytes"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "level"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,85 @@
+///
+/// GzipHeader.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2024 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+#include <string>
+
+namespace margelo::nitro::rnzlib {
+
+  /**
+   * A struct which can be represented as a JavaScript object (GzipHeader).
+   */
+  struct GzipHeader {
+  public:
+    bool text     SWIFT_PRIVATE;
+    double mtime     SWIFT_PRIVATE;
+    double os     SWIFT_PRIVATE;
+    std::optional<std::string> name     SWIFT_PRIVATE;
+    std::optional<std::string> comment     SWIFT_PRIVATE;
+
+  public:
+    explicit GzipHeader(bool text, double mtime, double os, std::optional<std::string> name, std::optional<std::string> comment): text(text), mtime(mtime), os(os), name(name), comment(comment) {}
+  };
+
+} // namespace margelo::nitro::rnzlib
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::rnzlib;
+
+  // C++ GzipHeader <> JS GzipHeader (object)
+  template <>
+  struct JSIConverter<GzipHeader> {
+    static inline GzipHeader fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return GzipHeader(
+        JSIConverter<bool>::fromJSI(runtime, obj.getProperty(runtime, "text")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "mtime")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "os")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "name")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "comment"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const GzipHeader& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "text", JSIConverter<bool>::toJSI(runtime, arg.text));
+      obj.setProperty(runtime, "mtime", JSIConverter<double>::toJSI(runtime, arg.mtime));
+      obj.setProperty(runtime, "os", JSIConverter<double>::toJSI(runtime, arg.os));
+      obj.setProperty(runtime, "name", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.name));
+      obj.setProperty(runtime, "comment", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.comment));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<bool>::canConvert(runtime, obj.getProperty(runtime, "text"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "mtime"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "os"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "name"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "comment"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,22 @@
+///
+/// HybridAbortTokenSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2024 Marc Rousavy @ Margelo
+///
+
+#include "HybridAbortTokenSpec.hpp"
+
+namespace margelo::nitro::rnzlib {
+
+  void HybridAbortTokenSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridGetter("aborted", &HybridAbortTokenSpec::getAborted);
+      prototype.registerHybridMethod("abort", &HybridAbortTokenSpec::abort);
+    });
+  }
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,60 @@
+///
+/// HybridAbortTokenSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2024 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+namespace margelo::nitro::rnzlib {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `AbortToken`
+   * Inherit this class to create instances of `HybridAbortTokenSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridAbortToken: public HybridAbortTokenSpec {
+   * public:
+   *   HybridAbortToken(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridAbortTokenSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridAbortTokenSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      virtual ~HybridAbortTokenSpec() { }
+
+    public:
+      // Properties
+      virtual bool getAborted() = 0;
+
+    public:
+      // Methods
+      virtual void abort() = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "AbortToken";
+  };
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,22 @@
+///
+/// HybridCompressedBufferSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2024 Marc Rousavy @ Margelo
+///
+
+#include "HybridCompressedBufferSpec.hpp"
+
+namespace margelo::nitro::rnzlib {
+
+  void HybridCompressedBufferSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridGetter("byteLength", &HybridCompressedBufferSpec::getByteLength);
+      prototype.registerHybridMethod("toArrayBuffer", &HybridCompressedBufferSpec::toArrayBuffer);
+    });
+  }
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,63 @@
+///
+/// HybridCompressedBufferSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2024 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `ArrayBuffer` to properly resolve imports.
+namespace NitroModules { class ArrayBuffer; }
+
+#include <NitroModules/ArrayBuffer.hpp>
+
+namespace margelo::nitro::rnzlib {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `CompressedBuffer`
+   * Inherit this class to create instances of `HybridCompressedBufferSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridCompressedBuffer: public HybridCompressedBufferSpec {
+   * public:
+   *   HybridCompressedBuffer(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridCompressedBufferSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridCompressedBufferSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      virtual ~HybridCompressedBufferSpec() { }
+
+    public:
+      // Properties
+      virtual double getByteLength() = 0;
+
+    public:
+      // Methods
+      virtual std::shared_ptr<ArrayBuffer> toArrayBuffer() = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "CompressedBuffer";
+  };
+
+} // namespace margelo::nitro::rnzlib
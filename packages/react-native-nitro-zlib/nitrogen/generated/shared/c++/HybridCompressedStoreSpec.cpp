@@ -0,0 +1,30 @@
+///
+/// HybridCompressedStoreSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2024 Marc Rousavy @ Margelo
+///
+
+#include "HybridCompressedStoreSpec.hpp"
+
+namespace margelo::nitro::rnzlib {
+
+  void HybridCompressedStoreSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridGetter("size", &HybridCompressedStoreSpec::getSize);
+      prototype.registerHybridGetter("compressedBytes", &HybridCompressedStoreSpec::getCompressedBytes);
+      prototype.registerHybridGetter("originalBytes", &HybridCompressedStoreSpec::getOriginalBytes);
+      prototype.registerHybridGetter("hotBytes", &HybridCompressedStoreSpec::getHotBytes);
+      prototype.registerHybridGetter("evictions", &HybridCompressedStoreSpec::getEvictions);
+      prototype.registerHybridMethod("put", &HybridCompressedStoreSpec::put);
+      prototype.registerHybridMethod("get", &HybridCompressedStoreSpec::get);
+      prototype.registerHybridMethod("has", &HybridCompressedStoreSpec::has);
+      prototype.registerHybridMethod("remove", &HybridCompressedStoreSpec::remove);
+      prototype.registerHybridMethod("clear", &HybridCompressedStoreSpec::clear);
+    });
+  }
+
+} // namespace margelo::nitro::rnzlib
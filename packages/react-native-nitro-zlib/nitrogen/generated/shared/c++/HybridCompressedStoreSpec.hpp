@@ -0,0 +1,74 @@
+///
+/// HybridCompressedStoreSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2024 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `ArrayBuffer` to properly resolve imports.
+namespace NitroModules { class ArrayBuffer; }
+
+#include <future>
+#include <string>
+#include <NitroModules/ArrayBuffer.hpp>
+#include <optional>
+
+namespace margelo::nitro::rnzlib {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `CompressedStore`
+   * Inherit this class to create instances of `HybridCompressedStoreSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridCompressedStore: public HybridCompressedStoreSpec {
+   * public:
+   *   HybridCompressedStore(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridCompressedStoreSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridCompressedStoreSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      virtual ~HybridCompressedStoreSpec() { }
+
+    public:
+      // Properties
+      virtual double getSize() = 0;
+      virtual double getCompressedBytes() = 0;
+      virtual double getOriginalBytes() = 0;
+      virtual double getHotBytes() = 0;
+      virtual double getEvictions() = 0;
+
+    public:
+      // Methods
+      virtual std::future<void> put(const std::string& key, const std::shared_ptr<ArrayBuffer>& data) = 0;
+      virtual std::optional<std::shared_ptr<ArrayBuffer>> get(const std::string& key) = 0;
+      virtual bool has(const std::string& key) = 0;
+      virtual bool remove(const std::string& key) = 0;
+      virtual void clear() = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "CompressedStore";
+  };
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,26 @@
+///
+/// HybridContentDecoderSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2024 Marc Rousavy @ Margelo
+///
+
+#include "HybridContentDecoderSpec.hpp"
+
+namespace margelo::nitro::rnzlib {
+
+  void HybridContentDecoderSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridGetter("readable", &HybridContentDecoderSpec::getReadable);
+      prototype.registerHybridGetter("readOffset", &HybridContentDecoderSpec::getReadOffset);
+      prototype.registerHybridGetter("finished", &HybridContentDecoderSpec::getFinished);
+      prototype.registerHybridMethod("write", &HybridContentDecoderSpec::write);
+      prototype.registerHybridMethod("consume", &HybridContentDecoderSpec::consume);
+      prototype.registerHybridMethod("end", &HybridContentDecoderSpec::end);
+    });
+  }
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,68 @@
+///
+/// HybridContentDecoderSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2024 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `ArrayBuffer` to properly resolve imports.
+namespace NitroModules { class ArrayBuffer; }
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <optional>
+
+namespace margelo::nitro::rnzlib {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `ContentDecoder`
+   * Inherit this class to create instances of `HybridContentDecoderSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridContentDecoder: public HybridContentDecoderSpec {
+   * public:
+   *   HybridContentDecoder(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridContentDecoderSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridContentDecoderSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      virtual ~HybridContentDecoderSpec() { }
+
+    public:
+      // Properties
+      virtual double getReadable() = 0;
+      virtual double getReadOffset() = 0;
+      virtual bool getFinished() = 0;
+
+    public:
+      // Methods
+      virtual double write(const std::shared_ptr<ArrayBuffer>& chunk, std::optional<double> byteOffset, std::optional<double> byteLength) = 0;
+      virtual double consume(double bytes) = 0;
+      virtual void end() = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "ContentDecoder";
+  };
+
+} // namespace margelo::nitro::rnzlib
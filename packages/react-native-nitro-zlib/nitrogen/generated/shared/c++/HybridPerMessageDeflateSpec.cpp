@@ -0,0 +1,25 @@
+///
+/// HybridPerMessageDeflateSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2024 Marc Rousavy @ Margelo
+///
+
+#include "HybridPerMessageDeflateSpec.hpp"
+
+namespace margelo::nitro::rnzlib {
+
+  void HybridPerMessageDeflateSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridMethod("offer", &HybridPerMessageDeflateSpec::offer);
+      prototype.registerHybridMethod("negotiate", &HybridPerMessageDeflateSpec::negotiate);
+      prototype.registerHybridMethod("compress", &HybridPerMessageDeflateSpec::compress);
+      prototype.registerHybridMethod("decompress", &HybridPerMessageDeflateSpec::decompress);
+      prototype.registerHybridMethod("reset", &HybridPerMessageDeflateSpec::reset);
+    });
+  }
+
+} // namespace margelo::nitro::rnzlib
@@ -0,0 +1,69 @@
+///
+/// HybridPerMessageDeflateSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2024 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `ArrayBuffer` to properly resolve imports.
+namespace NitroModules { class ArrayBuffer; }
+
+#include <string>
+#include <NitroModules/ArrayBuffer.hpp>
+#include <optional>
+
+namespace margelo::nitro::rnzlib {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `PerMessageDeflate`
+   * Inherit this class to create instances of `HybridPerMessageDeflateSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridPerMessageDeflate: public HybridPerMessageDeflateSpec {
+   * public:
+   *   HybridPerMessageDeflate(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridPerMessageDeflateSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridPerMessageDeflateSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      virtual ~HybridPerMessageDeflateSpec() { }
+
+    public:
+      // Properties
+      
+
+    public:
+      // Methods
+      virtual std::string offer() = 0;
+      virtual std::string negotiate(const std::string& header) = 0;
+      virtual std::shared_ptr<ArrayBuffer> compress(const std::shared_ptr<ArrayBuffer>& message, std::optional<double> byteOffset, std::optional<double> byteLength) = 0;
+      virtual std::shared_ptr<ArrayBuffer> decompress(const std::shared_ptr<ArrayBuffer>& payload, std::optional<double> byteOffset, std::optional<double> byteLength) = 0;
+      virtual void reset() = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "PerMessageDeflate";
+  };
+
+} // namespace margelo::nitro::rnzlib
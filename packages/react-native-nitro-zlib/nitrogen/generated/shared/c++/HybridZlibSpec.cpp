@@ -29,6 +29,7 @@ namespace margelo::nitro::rnzlib {
       prototype.registerHybridMethod("deflateRaw", &HybridZlibSpec::deflateRaw);
       prototype.registerHybridMethod("gzip", &HybridZlibSpec::gzip);
       prototype.registerHybridMethod("gunzip", &HybridZlibSpec::gunzip);
+      prototype.registerHybridMethod("gunzipParallel", &HybridZlibSpec::gunzipParallel);
       prototype.registerHybridMethod("createDeflateStream", &HybridZlibSpec::createDeflateStream);
       prototype.registerHybridMethod("createInflateStream", &HybridZlibSpec::createInflateStream);
       prototype.registerHybridMethod("createGzipStream", &HybridZlibSpec::createGzipStream);
@@ -36,6 +37,49 @@ namespace margelo::nitro::rnzlib {
       prototype.registerHybridMethod("createDeflateRawStream", &HybridZlibSpec::createDeflateRawStream);
       prototype.registerHybridMethod("createInflateRawStream", &HybridZlibSpec::createInflateRawStream);
       prototype.registerHybridMethod("createUnzipStream", &HybridZlibSpec::createUnzipStream);
+      prototype.registerHybridMethod("createPerMessageDeflate", &HybridZlibSpec::createPerMessageDeflate);
+      prototype.registerHybridMethod("createContentDecoder", &HybridZlibSpec::createContentDecoder);
+      prototype.registerHybridMethod("createAbortToken", &HybridZlibSpec::createAbortToken);
+      prototype.registerHybridMethod("createCompressedStore", &HybridZlibSpec::createCompressedStore);
+      prototype.registerHybridMethod("unzipSync", &HybridZlibSpec::unzipSync);
+      prototype.registerHybridMethod("unzip", &HybridZlibSpec::unzip);
+      prototype.registerHybridMethod("inflateInto", &HybridZlibSpec::inflateInto);
+      prototype.registerHybridMethod("gunzipInto", &HybridZlibSpec::gunzipInto);
+      prototype.registerHybridMethod("deflateInto", &HybridZlibSpec::deflateInto);
+      prototype.registerHybridMethod("deflateString", &HybridZlibSpec::deflateString);
+      prototype.registerHybridMethod("gzipString", &HybridZlibSpec::gzipString);
+      prototype.registerHybridMethod("inflateToString", &HybridZlibSpec::inflateToString);
+      prototype.registerHybridMethod("gunzipToString", &HybridZlibSpec::gunzipToString);
+      prototype.registerHybridMethod("deflateToBase64", &HybridZlibSpec::deflateToBase64);
+      prototype.registerHybridMethod("gzipToBase64", &HybridZlibSpec::gzipToBase64);
+      prototype.registerHybridMethod("inflateFromBase64", &HybridZlibSpec::inflateFromBase64);
+      prototype.registerHybridMethod("gunzipFromBase64", &HybridZlibSpec::gunzipFromBase64);
+      prototype.registerHybridMethod("deflateToHandle", &HybridZlibSpec::deflateToHandle);
+      prototype.registerHybridMethod("gzipToHandle", &HybridZlibSpec::gzipToHandle);
+      prototype.registerHybridMethod("inflateToHandle", &HybridZlibSpec::inflateToHandle);
+      prototype.registerHybridMethod("gunzipToHandle", &HybridZlibSpec::gunzipToHandle);
+      prototype.registerHybridMethod("unzipToHandle", &HybridZlibSpec::unzipToHandle);
+      prototype.registerHybridMethod("inflateSegmented", &HybridZlibSpec::inflateSegmented);
+      prototype.registerHybridMethod("gunzipSegmented", &HybridZlibSpec::gunzipSegmented);
+      prototype.registerHybridMethod("unzipSegmented", &HybridZlibSpec::unzipSegmented);
+      prototype.registerHybridMethod("inflateSyncWithInfo", &HybridZlibSpec::inflateSyncWithInfo);
+      prototype.registerHybridMethod("inflateRawSyncWithInfo", &HybridZlibSpec::inflateRawSyncWithInfo);
+      prototype.registerHybridMethod("compressSyncWithInfo", &HybridZlibSpec::compressSyncWithInfo);
+      prototype.registerHybridMethod("deflateSyncWithInfo", &HybridZlibSpec::deflateSyncWithInfo);
+      prototype.registerHybridMethod("deflateRawSyncWithInfo", &HybridZlibSpec::deflateRawSyncWithInfo);
+      prototype.registerHybridMethod("gzipSyncWithInfo", &HybridZlibSpec::gzipSyncWithInfo);
+      prototype.registerHybridMethod("gunzipSyncWithInfo", &HybridZlibSpec::gunzipSyncWithInfo);
+      prototype.registerHybridMethod("inflateWithInfo", &HybridZlibSpec::inflateWithInfo);
+      prototype.registerHybridMethod("inflateRawWithInfo", &HybridZlibSpec::inflateRawWithInfo);
+      prototype.registerHybridMethod("compressWithInfo", &HybridZlibSpec::compressWithInfo);
+      prototype.registerHybridMethod("deflateWithInfo", &HybridZlibSpec::deflateWithInfo);
+      prototype.registerHybridMethod("deflateRawWithInfo", &HybridZlibSpec::deflateRawWithInfo);
+      prototype.registerHybridMethod("gzipWithInfo", &HybridZlibSpec::gzipWithInfo);
+      prototype.registerHybridMethod("gunzipWithInfo", &HybridZlibSpec::gunzipWithInfo);
+      prototype.registerHybridMethod("setMetricsEnabled", &HybridZlibSpec::setMetricsEnabled);
+      prototype.registerHybridMethod("getMetrics", &HybridZlibSpec::getMetrics);
+      prototype.registerHybridMethod("resetMetrics", &HybridZlibSpec::resetMetrics);
+      prototype.registerHybridMethod("tune", &HybridZlibSpec::tune);
     });
   }
 
@@ -19,6 +19,28 @@ namespace NitroModules { class ArrayBuffer; }
 namespace margelo::nitro::rnzlib { struct ZlibOptions; }
 // Forward declaration of `HybridZlibStreamSpec` to properly resolve imports.
 namespace margelo::nitro::rnzlib { class HybridZlibStreamSpec; }
+// Forward declaration of `HybridPerMessageDeflateSpec` to properly resolve imports.
+namespace margelo::nitro::rnzlib { class HybridPerMessageDeflateSpec; }
+// Forward declaration of `PerMessageDeflateOptions` to properly resolve imports.
+namespace margelo::nitro::rnzlib { struct PerMessageDeflateOptions; }
+// Forward declaration of `HybridContentDecoderSpec` to properly resolve imports.
+namespace margelo::nitro::rnzlib { class HybridContentDecoderSpec; }
+// Forward declaration of `HybridCompressedBufferSpec` to properly resolve imports.
+namespace margelo::nitro::rnzlib { class HybridCompressedBufferSpec; }
+// Forward declaration of `HybridAbortTokenSpec` to properly resolve imports.
+namespace margelo::nitro::rnzlib { class HybridAbortTokenSpec; }
+// Forward declaration of `HybridCompressedStoreSpec` to properly resolve imports.
+namespace margelo::nitro::rnzlib { class HybridCompressedStoreSpec; }
+// Forward declaration of `CompressedStoreOptions` to properly resolve imports.
+namespace margelo::nitro::rnzlib { struct CompressedStoreOptions; }
+// Forward declaration of `OperationMetrics` to properly resolve imports.
+namespace margelo::nitro::rnzlib { struct OperationMetrics; }
+// Forward declaration of `ZlibResult` to properly resolve imports.
+namespace margelo::nitro::rnzlib { struct ZlibResult; }
+// Forward declaration of `TuneResult` to properly resolve imports.
+namespace margelo::nitro::rnzlib { struct TuneResult; }
+// Forward declaration of `TuneObjective` to properly resolve imports.
+namespace margelo::nitro::rnzlib { struct TuneObjective; }
 
 #include <string>
 #include <NitroModules/ArrayBuffer.hpp>
@@ -27,6 +49,19 @@ namespace margelo::nitro::rnzlib { class HybridZlibStreamSpec; }
 #include <future>
 #include <memory>
 #include "HybridZlibStreamSpec.hpp"
+#include "HybridPerMessageDeflateSpec.hpp"
+#include "PerMessageDeflateOptions.hpp"
+#include "HybridContentDecoderSpec.hpp"
+#include "HybridCompressedBufferSpec.hpp"
+#include <variant>
+#include "HybridAbortTokenSpec.hpp"
+#include "HybridCompressedStoreSpec.hpp"
+#include "CompressedStoreOptions.hpp"
+#include <vector>
+#include "OperationMetrics.hpp"
+#include "ZlibResult.hpp"
+#include "TuneResult.hpp"
+#include "TuneObjective.hpp"
 
 namespace margelo::nitro::rnzlib {
 
@@ -73,6 +108,7 @@ namespace margelo::nitro::rnzlib {
       virtual std::future<std::shared_ptr<ArrayBuffer>> deflateRaw(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
       virtual std::future<std::shared_ptr<ArrayBuffer>> gzip(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
       virtual std::future<std::shared_ptr<ArrayBuffer>> gunzip(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::future<std::shared_ptr<ArrayBuffer>> gunzipParallel(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
       virtual std::shared_ptr<margelo::nitro::rnzlib::HybridZlibStreamSpec> createDeflateStream(const std::optional<ZlibOptions>& options) = 0;
       virtual std::shared_ptr<margelo::nitro::rnzlib::HybridZlibStreamSpec> createInflateStream(const std::optional<ZlibOptions>& options) = 0;
       virtual std::shared_ptr<margelo::nitro::rnzlib::HybridZlibStreamSpec> createGzipStream(const std::optional<ZlibOptions>& options) = 0;
@@ -80,6 +116,49 @@ namespace margelo::nitro::rnzlib {
       virtual std::shared_ptr<margelo::nitro::rnzlib::HybridZlibStreamSpec> createDeflateRawStream(const std::optional<ZlibOptions>& options) = 0;
       virtual std::shared_ptr<margelo::nitro::rnzlib::HybridZlibStreamSpec> createInflateRawStream(const std::optional<ZlibOptions>& options) = 0;
       virtual std::shared_ptr<margelo::nitro::rnzlib::HybridZlibStreamSpec> createUnzipStream(const std::optional<ZlibOptions>& options) = 0;
+      virtual std::shared_ptr<margelo::nitro::rnzlib::HybridPerMessageDeflateSpec> createPerMessageDeflate(const PerMessageDeflateOptions& options) = 0;
+      virtual std::shared_ptr<margelo::nitro::rnzlib::HybridContentDecoderSpec> createContentDecoder(const std::string& encoding, const std::shared_ptr<ArrayBuffer>& ring) = 0;
+      virtual std::shared_ptr<margelo::nitro::rnzlib::HybridAbortTokenSpec> createAbortToken() = 0;
+      virtual std::shared_ptr<margelo::nitro::rnzlib::HybridCompressedStoreSpec> createCompressedStore(const std::optional<CompressedStoreOptions>& options) = 0;
+      virtual std::shared_ptr<ArrayBuffer> unzipSync(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::future<std::shared_ptr<ArrayBuffer>> unzip(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual double inflateInto(const std::shared_ptr<ArrayBuffer>& data, const std::shared_ptr<ArrayBuffer>& dst, std::optional<double> dstOffset, const std::optional<ZlibOptions>& options) = 0;
+      virtual double gunzipInto(const std::shared_ptr<ArrayBuffer>& data, const std::shared_ptr<ArrayBuffer>& dst, std::optional<double> dstOffset, const std::optional<ZlibOptions>& options) = 0;
+      virtual double deflateInto(const std::shared_ptr<ArrayBuffer>& data, const std::shared_ptr<ArrayBuffer>& dst, std::optional<double> dstOffset, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::shared_ptr<ArrayBuffer> deflateString(const std::string& text, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::shared_ptr<ArrayBuffer> gzipString(const std::string& text, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::string inflateToString(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::string gunzipToString(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::string deflateToBase64(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::string gzipToBase64(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::shared_ptr<ArrayBuffer> inflateFromBase64(const std::string& base64, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::shared_ptr<ArrayBuffer> gunzipFromBase64(const std::string& base64, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::shared_ptr<margelo::nitro::rnzlib::HybridCompressedBufferSpec> deflateToHandle(const std::variant<std::shared_ptr<ArrayBuffer>, std::shared_ptr<margelo::nitro::rnzlib::HybridCompressedBufferSpec>>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::shared_ptr<margelo::nitro::rnzlib::HybridCompressedBufferSpec> gzipToHandle(const std::variant<std::shared_ptr<ArrayBuffer>, std::shared_ptr<margelo::nitro::rnzlib::HybridCompressedBufferSpec>>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::shared_ptr<margelo::nitro::rnzlib::HybridCompressedBufferSpec> inflateToHandle(const std::variant<std::shared_ptr<ArrayBuffer>, std::shared_ptr<margelo::nitro::rnzlib::HybridCompressedBufferSpec>>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::shared_ptr<margelo::nitro::rnzlib::HybridCompressedBufferSpec> gunzipToHandle(const std::variant<std::shared_ptr<ArrayBuffer>, std::shared_ptr<margelo::nitro::rnzlib::HybridCompressedBufferSpec>>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::shared_ptr<margelo::nitro::rnzlib::HybridCompressedBufferSpec> unzipToHandle(const std::variant<std::shared_ptr<ArrayBuffer>, std::shared_ptr<margelo::nitro::rnzlib::HybridCompressedBufferSpec>>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::future<std::vector<std::shared_ptr<ArrayBuffer>>> inflateSegmented(const std::shared_ptr<ArrayBuffer>& data, std::optional<double> segmentSize, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::future<std::vector<std::shared_ptr<ArrayBuffer>>> gunzipSegmented(const std::shared_ptr<ArrayBuffer>& data, std::optional<double> segmentSize, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::future<std::vector<std::shared_ptr<ArrayBuffer>>> unzipSegmented(const std::shared_ptr<ArrayBuffer>& data, std::optional<double> segmentSize, const std::optional<ZlibOptions>& options) = 0;
+      virtual ZlibResult inflateSyncWithInfo(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual ZlibResult inflateRawSyncWithInfo(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual ZlibResult compressSyncWithInfo(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual ZlibResult deflateSyncWithInfo(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual ZlibResult deflateRawSyncWithInfo(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual ZlibResult gzipSyncWithInfo(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual ZlibResult gunzipSyncWithInfo(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::future<ZlibResult> inflateWithInfo(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::future<ZlibResult> inflateRawWithInfo(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::future<ZlibResult> compressWithInfo(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::future<ZlibResult> deflateWithInfo(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::future<ZlibResult> deflateRawWithInfo(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::future<ZlibResult> gzipWithInfo(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual std::future<ZlibResult> gunzipWithInfo(const std::shared_ptr<ArrayBuffer>& data, const std::optional<ZlibOptions>& options) = 0;
+      virtual void setMetricsEnabled(bool enabled) = 0;
+      virtual std::vector<OperationMetrics> getMetrics() = 0;
+      virtual void resetMetrics() = 0;
+      virtual std::future<TuneResult> tune(const std::vector<std::shared_ptr<ArrayBuffer>>& samples, const std::optional<TuneObjective>& objective) = 0;
 
     protected:
       // Hybrid Setup
@@ -54,7 +54,7 @@ namespace margelo::nitro::rnzlib {
 
     public:
       // Methods
-      virtual bool write(const std::shared_ptr<ArrayBuffer>& chunk) = 0;
+      virtual bool write(const std::shared_ptr<ArrayBuffer>& chunk, std::optional<double> byteOffset, std::optional<double> byteLength) = 0;
       virtual void end() = 0;
       virtual void flush(std::optional<double> kind) = 0;
       virtual void onData(const std::function<void(const std::shared_ptr<ArrayBuffer>& /* chunk */)>& callback) = 0;
@@ -0,0 +1,112 @@
+///
+/// OperationMetrics.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2024 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+
+namespace margelo::nitro::rnzlib {
+
+  /**
+   * A struct which can be represented as a JavaScript object (OperationMetrics).
+   */
+  struct OperationMetrics {
+  public:
+    std::string operation     SWIFT_PRIVATE;
+    double calls     SWIFT_PRIVATE;
+    double errors     SWIFT_PRIVATE;
+    double bytesIn     SWIFT_PRIVATE;
+    double bytesOut     SWIFT_PRIVATE;
+    double ratio     SWIFT_PRIVATE;
+    double totalMs     SWIFT_PRIVATE;
+    double meanMs     SWIFT_PRIVATE;
+    double p50Ms     SWIFT_PRIVATE;
+    double p90Ms     SWIFT_PRIVATE;
+    double p99Ms     SWIFT_PRIVATE;
+    double maxMs     SWIFT_PRIVATE;
+
+  public:
+    explicit OperationMetrics(std::string operation, double calls, double errors, double bytesIn, double bytesOut, double ratio, double totalMs, double meanMs, double p50Ms, double p90Ms, double p99Ms, double maxMs): operation(operation), calls(calls), errors(errors), bytesIn(bytesIn), bytesOut(bytesOut), ratio(ratio), totalMs(totalMs), meanMs(meanMs), p50Ms(p50Ms), p90Ms(p90Ms), p99Ms(p99Ms), maxMs(maxMs) {}
+  };
+
+} // namespace margelo::nitro::rnzlib
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::rnzlib;
+
+  // C++ OperationMetrics <> JS OperationMetrics (object)
+  template <>
+  struct JSIConverter<OperationMetrics> {
+    static inline OperationMetrics fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return OperationMetrics(
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "operation")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "calls")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "errors")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "bytesIn")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "bytesOut")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "ratio")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "totalMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "meanMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "p50Ms")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "p90Ms")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "p99Ms")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "maxMs"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const OperationMetrics& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "operation", JSIConverter<std::string>::toJSI(runtime, arg.operation));
+      obj.setProperty(runtime, "calls", JSIConverter<double>::toJSI(runtime, arg.calls));
+      obj.setProperty(runtime, "errors", JSIConverter<double>::toJSI(runtime, arg.errors));
+      obj.setProperty(runtime, "bytesIn", JSIConverter<double>::toJSI(runtime, arg.bytesIn));
+      obj.setProperty(runtime, "bytesOut", JSIConverter<double>::toJSI(runtime, arg.bytesOut));
+      obj.setProperty(runtime, "ratio", JSIConverter<double>::toJSI(runtime, arg.ratio));
+      obj.setProperty(runtime, "totalMs", JSIConverter<double>::toJSI(runtime, arg.totalMs));
+      obj.setProperty(runtime, "meanMs", JSIConverter<double>::toJSI(runtime, arg.meanMs));
+      obj.setProperty(runtime, "p50Ms", JSIConverter<double>::toJSI(runtime, arg.p50Ms));
+      obj.setProperty(runtime, "p90Ms", JSIConverter<double>::toJSI(runtime, arg.p90Ms));
+      obj.setProperty(runtime, "p99Ms", JSIConverter<double>::toJSI(runtime, arg.p99Ms));
+      obj.setProperty(runtime, "maxMs", JSIConverter<double>::toJSI(runtime, arg.maxMs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "operation"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "calls"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "errors"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "bytesIn"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "bytesOut"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "ratio"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "totalMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "meanMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "p50Ms"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "p90Ms"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "p99Ms"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "maxMs"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,96 @@
+///
+/// PerMessageDeflateOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2024 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+
+namespace margelo::nitro::rnzlib {
+
+  /**
+   * A struct which can be represented as a JavaScript object (PerMessageDeflateOptions).
+   */
+  struct PerMessageDeflateOptions {
+  public:
+    bool isServer     SWIFT_PRIVATE;
+    std::optional<bool> serverNoContextTakeover     SWIFT_PRIVATE;
+    std::optional<bool> clientNoContextTakeover     SWIFT_PRIVATE;
+    std::optional<double> serverMaxWindowBits     SWIFT_PRIVATE;
+    std::optional<double> clientMaxWindowBits     SWIFT_PRIVATE;
+    std::optional<double> level     SWIFT_PRIVATE;
+    std::optional<double> memLevel     SWIFT_PRIVATE;
+    std::optional<double> maxMessageSize     SWIFT_PRIVATE;
+
+  public:
+    explicit PerMessageDeflateOptions(bool isServer, std::optional<bool> serverNoContextTakeover, std::optional<bool> clientNoContextTakeover, std::optional<double> serverMaxWindowBits, std::optional<double> clientMaxWindowBits, std::optional<double> level, std::optional<double> memLevel, std::optional<double> maxMessageSize): isServer(isServer), serverNoContextTakeover(serverNoContextTakeover), clientNoContextTakeover(clientNoContextTakeover), serverMaxWindowBits(serverMaxWindowBits), clientMaxWindowBits(clientMaxWindowBits), level(level), memLevel(memLevel), maxMessageSize(maxMessageSize) {}
+  };
+
+} // namespace margelo::nitro::rnzlib
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::rnzlib;
+
+  // C++ PerMessageDeflateOptions <> JS PerMessageDeflateOptions (object)
+  template <>
+  struct JSIConverter<PerMessageDeflateOptions> {
+    static inline PerMessageDeflateOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return PerMessageDeflateOptions(
+        JSIConverter<bool>::fromJSI(runtime, obj.getProperty(runtime, "isServer")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "serverNoContextTakeover")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "clientNoContextTakeover")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "serverMaxWindowBits")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "clientMaxWindowBits")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "level")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "memLevel")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxMessageSize"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const PerMessageDeflateOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "isServer", JSIConverter<bool>::toJSI(runtime, arg.isServer));
+      obj.setProperty(runtime, "serverNoContextTakeover", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.serverNoContextTakeover));
+      obj.setProperty(runtime, "clientNoContextTakeover", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.clientNoContextTakeover));
+      obj.setProperty(runtime, "serverMaxWindowBits", JSIConverter<std::optional<double>>::toJSI(runtime, arg.serverMaxWindowBits));
+      obj.setProperty(runtime, "clientMaxWindowBits", JSIConverter<std::optional<double>>::toJSI(runtime, arg.clientMaxWindowBits));
+      obj.setProperty(runtime, "level", JSIConverter<std::optional<double>>::toJSI(runtime, arg.level));
+      obj.setProperty(runtime, "memLevel", JSIConverter<std::optional<double>>::toJSI(runtime, arg.memLevel));
+      obj.setProperty(runtime, "maxMessageSize", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxMessageSize));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<bool>::canConvert(runtime, obj.getProperty(runtime, "isServer"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "serverNoContextTakeover"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "clientNoContextTakeover"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "serverMaxWindowBits"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "clientMaxWindowBits"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "level"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "memLevel"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxMessageSize"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,92 @@
+///
+/// TuneCandidate.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2024 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+
+
+namespace margelo::nitro::rnzlib {
+
+  /**
+   * A struct which can be represented as a JavaScript object (TuneCandidate).
+   */
+  struct TuneCandidate {
+  public:
+    double level     SWIFT_PRIVATE;
+    double windowBits     SWIFT_PRIVATE;
+    double memLevel     SWIFT_PRIVATE;
+    double strategy     SWIFT_PRIVATE;
+    double ratio     SWIFT_PRIVATE;
+    double throughputMBps     SWIFT_PRIVATE;
+    double memoryBytes     SWIFT_PRIVATE;
+
+  public:
+    explicit TuneCandidate(double level, double windowBits, double memLevel, double strategy, double ratio, double throughputMBps, double memoryBytes): level(level), windowBits(windowBits), memLevel(memLevel), strategy(strategy), ratio(ratio), throughputMBps(throughputMBps), memoryBytes(memoryBytes) {}
+  };
+
+} // namespace margelo::nitro::rnzlib
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::rnzlib;
+
+  // C++ TuneCandidate <> JS TuneCandidate (object)
+  template <>
+  struct JSIConverter<TuneCandidate> {
+    static inline TuneCandidate fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return TuneCandidate(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "level")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "windowBits")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "memLevel")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "strategy")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "ratio")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "throughputMBps")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "memoryBytes"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const TuneCandidate& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "level", JSIConverter<double>::toJSI(runtime, arg.level));
+      obj.setProperty(runtime, "windowBits", JSIConverter<double>::toJSI(runtime, arg.windowBits));
+      obj.setProperty(runtime, "memLevel", JSIConverter<double>::toJSI(runtime, arg.memLevel));
+      obj.setProperty(runtime, "strategy", JSIConverter<double>::toJSI(runtime, arg.strategy));
+      obj.setProperty(runtime, "ratio", JSIConverter<double>::toJSI(runtime, arg.ratio));
+      obj.setProperty(runtime, "throughputMBps", JSIConverter<double>::toJSI(runtime, arg.throughputMBps));
+      obj.setProperty(runtime, "memoryBytes", JSIConverter<double>::toJSI(runtime, arg.memoryBytes));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "level"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "windowBits"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "memLevel"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "strategy"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "ratio"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "throughputMBps"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "memoryBytes"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,76 @@
+///
+/// TuneObjective.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2024 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+
+namespace margelo::nitro::rnzlib {
+
+  /**
+   * A struct which can be represented as a JavaScript object (TuneObjective).
+   */
+  struct TuneObjective {
+  public:
+    std::optional<double> ratioWeight     SWIFT_PRIVATE;
+    std::optional<double> minThroughputMBps     SWIFT_PRIVATE;
+    std::optional<double> maxMemoryBytes     SWIFT_PRIVATE;
+
+  public:
+    explicit TuneObjective(std::optional<double> ratioWeight, std::optional<double> minThroughputMBps, std::optional<double> maxMemoryBytes): ratioWeight(ratioWeight), minThroughputMBps(minThroughputMBps), maxMemoryBytes(maxMemoryBytes) {}
+  };
+
+} // namespace margelo::nitro::rnzlib
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::rnzlib;
+
+  // C++ TuneObjective <> JS TuneObjective (object)
+  template <>
+  struct JSIConverter<TuneObjective> {
+    static inline TuneObjective fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return TuneObjective(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "ratioWeight")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "minThroughputMBps")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxMemoryBytes"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const TuneObjective& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "ratioWeight", JSIConverter<std::optional<double>>::toJSI(runtime, arg.ratioWeight));
+      obj.setProperty(runtime, "minThroughputMBps", JSIConverter<std::optional<double>>::toJSI(runtime, arg.minThroughputMBps));
+      obj.setProperty(runtime, "maxMemoryBytes", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxMemoryBytes));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "ratioWeight"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "minThroughputMBps"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxMemoryBytes"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,85 @@
+///
+/// TuneResult.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2024 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `TuneCandidate` to properly resolve imports.
+namespace margelo::nitro::rnzlib { struct TuneCandidate; }
+// Forward declaration of `ZlibOptions` to properly resolve imports.
+namespace margelo::nitro::rnzlib { struct ZlibOptions; }
+
+#include <vector>
+#include "TuneCandidate.hpp"
+#include "ZlibOptions.hpp"
+
+namespace margelo::nitro::rnzlib {
+
+  /**
+   * A struct which can be represented as a JavaScript object (TuneResult).
+   */
+  struct TuneResult {
+  public:
+    std::vector<TuneCandidate> frontier     SWIFT_PRIVATE;
+    TuneCandidate best     SWIFT_PRIVATE;
+    ZlibOptions recommended     SWIFT_PRIVATE;
+    double evaluated     SWIFT_PRIVATE;
+
+  public:
+    explicit TuneResult(std::vector<TuneCandidate> frontier, TuneCandidate best, ZlibOptions recommended, double evaluated): frontier(frontier), best(best), recommended(recommended), evaluated(evaluated) {}
+  };
+
+} // namespace margelo::nitro::rnzlib
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::rnzlib;
+
+  // C++ TuneResult <> JS TuneResult (object)
+  template <>
+  struct JSIConverter<TuneResult> {
+    static inline TuneResult fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return TuneResult(
+        JSIConverter<std::vector<TuneCandidate>>::fromJSI(runtime, obj.getProperty(runtime, "frontier")),
+        JSIConverter<TuneCandidate>::fromJSI(runtime, obj.getProperty(runtime, "best")),
+        JSIConverter<ZlibOptions>::fromJSI(runtime, obj.getProperty(runtime, "recommended")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "evaluated"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const TuneResult& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "frontier", JSIConverter<std::vector<TuneCandidate>>::toJSI(runtime, arg.frontier));
+      obj.setProperty(runtime, "best", JSIConverter<TuneCandidate>::toJSI(runtime, arg.best));
+      obj.setProperty(runtime, "recommended", JSIConverter<ZlibOptions>::toJSI(runtime, arg.recommended));
+      obj.setProperty(runtime, "evaluated", JSIConverter<double>::toJSI(runtime, arg.evaluated));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::vector<TuneCandidate>>::canConvert(runtime, obj.getProperty(runtime, "frontier"))) return false;
+      if (!JSIConverter<TuneCandidate>::canConvert(runtime, obj.getProperty(runtime, "best"))) return false;
+      if (!JSIConverter<ZlibOptions>::canConvert(runtime, obj.getProperty(runtime, "recommended"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "evaluated"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
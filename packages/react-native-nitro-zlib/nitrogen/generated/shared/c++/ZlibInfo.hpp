@@ -0,0 +1,101 @@
+///
+/// ZlibInfo.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2024 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `GzipHeader` to properly resolve imports.
+namespace margelo::nitro::rnzlib { struct GzipHeader; }
+// Forward declaration of `AdaptiveDecision` to properly resolve imports.
+namespace margelo::nitro::rnzlib { struct AdaptiveDecision; }
+
+#include <optional>
+#include "GzipHeader.hpp"
+#include "AdaptiveDecision.hpp"
+
+namespace margelo::nitro::rnzlib {
+
+  /**
+   * A struct which can be represented as a JavaScript object (ZlibInfo).
+   */
+  struct ZlibInfo {
+  public:
+    double wallTimeMs     SWIFT_PRIVATE;
+    double cpuTimeMs     SWIFT_PRIVATE;
+    double bytesIn     SWIFT_PRIVATE;
+    double bytesOut     SWIFT_PRIVATE;
+    double ratio     SWIFT_PRIVATE;
+    std::optional<double> checksum     SWIFT_PRIVATE;
+    std::optional<GzipHeader> gzipHeader     SWIFT_PRIVATE;
+    std::optional<AdaptiveDecision> adaptive     SWIFT_PRIVATE;
+
+  public:
+    explicit ZlibInfo(double wallTimeMs, double cpuTimeMs, double bytesIn, double bytesOut, double ratio, std::optional<double> checksum, std::optional<GzipHeader> gzipHeader, std::optional<AdaptiveDecision> adaptive): wallTimeMs(wallTimeMs), cpuTimeMs(cpuTimeMs), bytesIn(bytesIn), bytesOut(bytesOut), ratio(ratio), checksum(checksum), gzipHeader(gzipHeader), adaptive(adaptive) {}
+  };
+
+} // namespace margelo::nitro::rnzlib
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::rnzlib;
+
+  // C++ ZlibInfo <> JS ZlibInfo (object)
+  template <>
+  struct JSIConverter<ZlibInfo> {
+    static inline ZlibInfo fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return ZlibInfo(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "wallTimeMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "cpuTimeMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "bytesIn")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "bytesOut")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "ratio")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "checksum")),
+        JSIConverter<std::optional<GzipHeader>>::fromJSI(runtime, obj.getProperty(runtime, "gzipHeader")),
+        JSIConverter<std::optional<AdaptiveDecision>>::fromJSI(runtime, obj.getProperty(runtime, "adaptive"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const ZlibInfo& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "wallTimeMs", JSIConverter<double>::toJSI(runtime, arg.wallTimeMs));
+      obj.setProperty(runtime, "cpuTimeMs", JSIConverter<double>::toJSI(runtime, arg.cpuTimeMs));
+      obj.setProperty(runtime, "bytesIn", JSIConverter<double>::toJSI(runtime, arg.bytesIn));
+      obj.setProperty(runtime, "bytesOut", JSIConverter<double>::toJSI(runtime, arg.bytesOut));
+      obj.setProperty(runtime, "ratio", JSIConverter<double>::toJSI(runtime, arg.ratio));
+      obj.setProperty(runtime, "checksum", JSIConverter<std::optional<double>>::toJSI(runtime, arg.checksum));
+      obj.setProperty(runtime, "gzipHeader", JSIConverter<std::optional<GzipHeader>>::toJSI(runtime, arg.gzipHeader));
+      obj.setProperty(runtime, "adaptive", JSIConverter<std::optional<AdaptiveDecision>>::toJSI(runtime, arg.adaptive));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "wallTimeMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "cpuTimeMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "bytesIn"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "bytesOut"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "ratio"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "checksum"))) return false;
+      if (!JSIConverter<std::optional<GzipHeader>>::canConvert(runtime, obj.getProperty(runtime, "gzipHeader"))) return false;
+      if (!JSIConverter<std::optional<AdaptiveDecision>>::canConvert(runtime, obj.getProperty(runtime, "adaptive"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
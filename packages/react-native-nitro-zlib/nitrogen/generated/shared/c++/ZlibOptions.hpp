@@ -20,9 +20,14 @@
 
 // Forward declaration of `ArrayBuffer` to properly resolve imports.
 namespace NitroModules { class ArrayBuffer; }
+// Forward declaration of `HybridAbortTokenSpec` to properly resolve imports.
+namespace margelo::nitro::rnzlib { class HybridAbortTokenSpec; }
 
 #include <optional>
 #include <NitroModules/ArrayBuffer.hpp>
+#include <memory>
+#include "HybridAbortTokenSpec.hpp"
+#include <functional>
 
 namespace margelo::nitro::rnzlib {
 
@@ -41,9 +46,20 @@ namespace margelo::nitro::rnzlib {
     std::optional<std::shared_ptr<ArrayBuffer>> dictionary     SWIFT_PRIVATE;
     std::optional<bool> info     SWIFT_PRIVATE;
     std::optional<double> maxOutputLength     SWIFT_PRIVATE;
+    std::optional<bool> adaptive     SWIFT_PRIVATE;
+    std::optional<double> memoryProfile     SWIFT_PRIVATE;
+    std::optional<double> byteOffset     SWIFT_PRIVATE;
+    std::optional<double> byteLength     SWIFT_PRIVATE;
+    std::optional<std::shared_ptr<margelo::nitro::rnzlib::HybridAbortTokenSpec>> signal     SWIFT_PRIVATE;
+    std::optional<double> deadlineMs     SWIFT_PRIVATE;
+    std::optional<double> priority     SWIFT_PRIVATE;
+    std::optional<std::function<void(double /* bytesIn */, double /* bytesOut */)>> onProgress     SWIFT_PRIVATE;
+    std::optional<double> progressIntervalMs     SWIFT_PRIVATE;
+    std::optional<double> progressIntervalBytes     SWIFT_PRIVATE;
 
   public:
-    explicit ZlibOptions(std::optional<double> flush, std::optional<double> finishFlush, std::optional<double> chunkSize, std::optional<double> windowBits, std::optional<double> level, std::optional<double> memLevel, std::optional<double> strategy, std::optional<std::shared_ptr<ArrayBuffer>> dictionary, std::optional<bool> info, std::optional<double> maxOutputLength): flush(flush), finishFlush(finishFlush), chunkSize(chunkSize), windowBits(windowBits), level(level), memLevel(memLevel), strategy(strategy), dictionary(dictionary), info(info), maxOutputLength(maxOutputLength) {}
+    ZlibOptions() = default;
+    explicit ZlibOptions(std::optional<double> flush, std::optional<double> finishFlush, std::optional<double> chunkSize, std::optional<double> windowBits, std::optional<double> level, std::optional<double> memLevel, std::optional<double> strategy, std::optional<std::shared_ptr<ArrayBuffer>> dictionary, std::optional<bool> info, std::optional<double> maxOutputLength, std::optional<bool> adaptive, std::optional<double> memoryProfile, std::optional<double> byteOffset, std::optional<double> byteLength, std::optional<std::shared_ptr<margelo::nitro::rnzlib::HybridAbortTokenSpec>> signal, std::optional<double> deadlineMs, std::optional<double> priority, std::optional<std::function<void(double /* bytesIn */, double /* bytesOut */)>> onProgress, std::optional<double> progressIntervalMs, std::optional<double> progressIntervalBytes): flush(flush), finishFlush(finishFlush), chunkSize(chunkSize), windowBits(windowBits), level(level), memLevel(memLevel), strategy(strategy), dictionary(dictionary), info(info), maxOutputLength(maxOutputLength), adaptive(adaptive), memoryProfile(memoryProfile), byteOffset(byteOffset), byteLength(byteLength), signal(signal), deadlineMs(deadlineMs), priority(priority), onProgress(onProgress), progressIntervalMs(progressIntervalMs), progressIntervalBytes(progressIntervalBytes) {}
   };
 
 } // namespace margelo::nitro::rnzlib
@@ -67,7 +83,17 @@ namespace margelo::nitro {
         JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "strategy")),
         JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::fromJSI(runtime, obj.getProperty(runtime, "dictionary")),
         JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "info")),
-        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxOutputLength"))
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxOutputLength")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "adaptive")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "memoryProfile")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "byteOffset")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "byteLength")),
+        JSIConverter<std::optional<std::shared_ptr<margelo::nitro::rnzlib::HybridAbortTokenSpec>>>::fromJSI(runtime, obj.getProperty(runtime, "signal")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "deadlineMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "priority")),
+        JSIConverter<std::optional<std::function<void(double /* bytesIn */, double /* bytesOut */)>>>::fromJSI(runtime, obj.getProperty(runtime, "onProgress")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "progressIntervalMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "progressIntervalBytes"))
       );
     }
     static inline jsi::Value toJSI(jsi::Runtime& runtime, const ZlibOptions& arg) {
@@ -82,6 +108,16 @@ namespace margelo::nitro {
       obj.setProperty(runtime, "dictionary", JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::toJSI(runtime, arg.dictionary));
       obj.setProperty(runtime, "info", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.info));
       obj.setProperty(runtime, "maxOutputLength", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxOutputLength));
+      obj.setProperty(runtime, "adaptive", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.adaptive));
+      obj.setProperty(runtime, "memoryProfile", JSIConverter<std::optional<double>>::toJSI(runtime, arg.memoryProfile));
+      obj.setProperty(runtime, "byteOffset", JSIConverter<std::optional<double>>::toJSI(runtime, arg.byteOffset));
+      obj.setProperty(runtime, "byteLength", JSIConverter<std::optional<double>>::toJSI(runtime, arg.byteLength));
+      obj.setProperty(runtime, "signal", JSIConverter<std::optional<std::shared_ptr<margelo::nitro::rnzlib::HybridAbortTokenSpec>>>::toJSI(runtime, arg.signal));
+      obj.setProperty(runtime, "deadlineMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.deadlineMs));
+      obj.setProperty(runtime, "priority", JSIConverter<std::optional<double>>::toJSI(runtime, arg.priority));
+      obj.setProperty(runtime, "onProgress", JSIConverter<std::optional<std::function<void(double /* bytesIn */, double /* bytesOut */)>>>::toJSI(runtime, arg.onProgress));
+      obj.setProperty(runtime, "progressIntervalMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.progressIntervalMs));
+      obj.setProperty(runtime, "progressIntervalBytes", JSIConverter<std::optional<double>>::toJSI(runtime, arg.progressIntervalBytes));
       return obj;
     }
     static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
@@ -99,6 +135,16 @@ namespace margelo::nitro {
       if (!JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::canConvert(runtime, obj.getProperty(runtime, "dictionary"))) return false;
       if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "info"))) return false;
       if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxOutputLength"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "adaptive"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "memoryProfile"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "byteOffset"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "byteLength"))) return false;
+      if (!JSIConverter<std::optional<std::shared_ptr<margelo::nitro::rnzlib::HybridAbortTokenSpec>>>::canConvert(runtime, obj.getProperty(runtime, "signal"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "deadlineMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "priority"))) return false;
+      if (!JSIConverter<std::optional<std::function<void(double /* bytesIn */, double /* bytesOut */)>>>::canConvert(runtime, obj.getProperty(runtime, "onProgress"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "progressIntervalMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "progressIntervalBytes"))) return false;
       return true;
     }
   };
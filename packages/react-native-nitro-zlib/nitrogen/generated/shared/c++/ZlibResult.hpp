@@ -0,0 +1,76 @@
+///
+/// ZlibResult.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2024 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `ArrayBuffer` to properly resolve imports.
+namespace NitroModules { class ArrayBuffer; }
+// Forward declaration of `ZlibInfo` to properly resolve imports.
+namespace margelo::nitro::rnzlib { struct ZlibInfo; }
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include "ZlibInfo.hpp"
+
+namespace margelo::nitro::rnzlib {
+
+  /**
+   * A struct which can be represented as a JavaScript object (ZlibResult).
+   */
+  struct ZlibResult {
+  public:
+    std::shared_ptr<ArrayBuffer> buffer     SWIFT_PRIVATE;
+    ZlibInfo info     SWIFT_PRIVATE;
+
+  public:
+    explicit ZlibResult(std::shared_ptr<ArrayBuffer> buffer, ZlibInfo info): buffer(buffer), info(info) {}
+  };
+
+} // namespace margelo::nitro::rnzlib
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::rnzlib;
+
+  // C++ ZlibResult <> JS ZlibResult (object)
+  template <>
+  struct JSIConverter<ZlibResult> {
+    static inline ZlibResult fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return ZlibResult(
+        JSIConverter<std::shared_ptr<ArrayBuffer>>::fromJSI(runtime, obj.getProperty(runtime, "buffer")),
+        JSIConverter<ZlibInfo>::fromJSI(runtime, obj.getProperty(runtime, "info"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const ZlibResult& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "buffer", JSIConverter<std::shared_ptr<ArrayBuffer>>::toJSI(runtime, arg.buffer));
+      obj.setProperty(runtime, "info", JSIConverter<ZlibInfo>::toJSI(runtime, arg.info));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::shared_ptr<ArrayBuffer>>::canConvert(runtime, obj.getProperty(runtime, "buffer"))) return false;
+      if (!JSIConverter<ZlibInfo>::canConvert(runtime, obj.getProperty(runtime, "info"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -27,6 +27,31 @@ export const ZlibStrategy = {
   FIXED: 4,
 } as const
 
+/** Memory profiles for streams */
+export const ZlibMemoryProfile = {
+  DEFAULT: 0,
+  /**
+   * For many concurrent streams: small window and memLevel unless set
+   * explicitly, and a per-thread output buffer shared by all low-memory
+   * streams. zlib state is dropped at message boundaries that nothing later
+   * refers back across: raw deflate after a FULL_FLUSH, and inflate once the
+   * compressed stream ends. Zlib/gzip deflate and raw inflate keep it until
+   * end() or reset().
+   */
+  LOW: 1,
+} as const
+
+export const ZlibPriority = {
+  /** Ahead of all queued work, e.g. a response the UI is waiting for */
+  INTERACTIVE: 0,
+  NORMAL: 1,
+  /**
+   * Bulk work such as telemetry: runs on its own low-priority thread and
+   * pauses between chunks while interactive work is pending
+   */
+  BACKGROUND: 2,
+} as const
+
 // Type definitions for the constants
 export type ZlibCompressionLevel =
   | (typeof ZlibCompressionLevel)[keyof typeof ZlibCompressionLevel]
@@ -39,9 +64,14 @@ export type ZlibCompressionLevel =
   | 8
 export type ZlibFlush = (typeof ZlibFlush)[keyof typeof ZlibFlush]
 export type ZlibStrategy = (typeof ZlibStrategy)[keyof typeof ZlibStrategy]
+export type ZlibMemoryProfile =
+  (typeof ZlibMemoryProfile)[keyof typeof ZlibMemoryProfile]
+export type ZlibPriority = (typeof ZlibPriority)[keyof typeof ZlibPriority]
 
 export interface ZlibOptions {
+  /** One-shot methods: same as finishFlush, which wins when both are set */
   flush?: ZlibFlush
+  /** One-shot methods: flush for the final zlib call. Defaults to FINISH */
   finishFlush?: number
   chunkSize?: number
   windowBits?: number
@@ -49,13 +79,149 @@ export interface ZlibOptions {
   memLevel?: number
   strategy?: ZlibStrategy
   dictionary?: ArrayBuffer
+  /** Unused, call the *WithInfo variants to get a ZlibInfo */
   info?: boolean
   maxOutputLength?: number
+  /**
+   * Deflate only: sample the input first and use stored blocks (level 0) or
+   * level 1 when it doesn't compress (JPEG, video, already gzipped data).
+   */
+  adaptive?: boolean
+  /** Streams only, see ZlibMemoryProfile */
+  memoryProfile?: ZlibMemoryProfile
+  /**
+   * One-shot methods only: read `data` from this offset instead of slicing it
+   * in JS, which would copy
+   */
+  byteOffset?: number
+  /** Bytes to read from byteOffset, defaults to the rest of `data` */
+  byteLength?: number
+  /** One-shot methods only: abort() makes the call throw / the promise reject */
+  signal?: AbortToken
+  /** One-shot methods only: fail once this many ms have passed since the call */
+  deadlineMs?: number
+  /** Async one-shot methods only, see ZlibPriority. Defaults to NORMAL */
+  priority?: ZlibPriority
+  /**
+   * Async one-shot methods only: called with the bytes consumed and produced
+   * so far, throttled by progressIntervalMs / progressIntervalBytes, and once
+   * more with the final totals
+   */
+  onProgress?: (bytesIn: number, bytesOut: number) => void
+  /** Minimum time between two onProgress calls. Defaults to 100 */
+  progressIntervalMs?: number
+  /** Minimum input bytes between two onProgress calls. Defaults to 0 */
+  progressIntervalBytes?: number
+}
+
+/** Cancels the one-shot operations it was passed to, see ZlibOptions.signal */
+export interface AbortToken
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  readonly aborted: boolean
+  abort(): void
+}
+
+/** Gzip member header fields, as parsed by gunzip */
+export interface GzipHeader {
+  text: boolean
+  /** Modification time in seconds since the epoch, 0 if not set */
+  mtime: number
+  /** Operating system code from RFC 1952 */
+  os: number
+  name?: string
+  comment?: string
+}
+
+/** Native measurements of a single one-shot call */
+export interface ZlibInfo {
+  wallTimeMs: number
+  /** CPU time of the thread that ran the codec */
+  cpuTimeMs: number
+  /** Bytes consumed from the input */
+  bytesIn: number
+  /** Bytes produced */
+  bytesOut: number
+  /** bytesOut / bytesIn */
+  ratio: number
+  /** adler32 (zlib) or crc32 (gzip) of the uncompressed data, undefined for raw deflate */
+  checksum?: number
+  /** Set when a gzip header was parsed (gunzip only) */
+  gzipHeader?: GzipHeader
+  /** Set when `adaptive` was requested on a deflate method */
+  adaptive?: AdaptiveDecision
+}
+
+/** What an adaptive deflate decided after probing the input */
+export interface AdaptiveDecision {
+  /** Level actually used, 0 = stored blocks, -1 = zlib default */
+  level: number
+  /** Bits per byte over the sampled input, 0..8 */
+  entropy: number
+  /** Level 1 compression ratio of a trial sample, 0 when no trial was needed */
+  trialRatio: number
+}
+
+export interface ZlibResult {
+  buffer: ArrayBuffer
+  info: ZlibInfo
+}
+
+/** What tune() should optimize for */
+export interface TuneObjective {
+  /** 0 = fastest, 1 = smallest output, default 0.5 */
+  ratioWeight?: number
+  /** Skip candidates compressing slower than this */
+  minThroughputMBps?: number
+  /** Skip candidates whose deflate state needs more memory than this */
+  maxMemoryBytes?: number
+}
+
+/** One measured parameter set */
+export interface TuneCandidate {
+  level: number
+  windowBits: number
+  memLevel: number
+  strategy: number
+  /** compressed / original over all samples */
+  ratio: number
+  /** Compression throughput over all samples, single thread */
+  throughputMBps: number
+  /** Deflate state size as documented by zlib */
+  memoryBytes: number
+}
+
+export interface TuneResult {
+  /** Candidates no other candidate beats on ratio, throughput and memory at once, smallest ratio first */
+  frontier: TuneCandidate[]
+  /** Frontier point chosen for the objective */
+  best: TuneCandidate
+  /** `best` as options for deflate, gzip and their streams */
+  recommended: ZlibOptions
+  /** Number of candidates measured */
+  evaluated: number
+}
+
+/** Aggregated numbers for one API method since the last resetMetrics() */
+export interface OperationMetrics {
+  operation: string
+  calls: number
+  errors: number
+  bytesIn: number
+  bytesOut: number
+  /** bytesOut / bytesIn */
+  ratio: number
+  totalMs: number
+  meanMs: number
+  p50Ms: number
+  p90Ms: number
+  p99Ms: number
+  maxMs: number
 }
 
 export interface ZlibStream
   extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
-  write(chunk: ArrayBuffer): boolean
+  /** byteOffset/byteLength select part of `chunk` without copying it */
+  write(chunk: ArrayBuffer, byteOffset?: number, byteLength?: number): boolean
   end(): void
   flush(kind?: number): void
 
@@ -69,6 +235,114 @@ export interface ZlibStream
   getMemorySize(): number
 }
 
+/** WebSocket permessage-deflate (RFC 7692) settings for one connection */
+export interface PerMessageDeflateOptions {
+  isServer: boolean
+  /** Ask for / require a fresh deflate context per server message */
+  serverNoContextTakeover?: boolean
+  /** Ask for / require a fresh deflate context per client message */
+  clientNoContextTakeover?: boolean
+  /** Largest server window to offer or accept, 9..15 */
+  serverMaxWindowBits?: number
+  /** Largest client window to offer or accept, 9..15 */
+  clientMaxWindowBits?: number
+  level?: ZlibCompressionLevel
+  memLevel?: number
+  /** decompress() throws when a message inflates to more than this */
+  maxMessageSize?: number
+}
+
+export interface PerMessageDeflate
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  /** Client only: the Sec-WebSocket-Extensions value to send */
+  offer(): string
+  /**
+   * Server: pass the client's Sec-WebSocket-Extensions, returns the response
+   * value or '' when no offer is acceptable. Client: pass the server's
+   * response, throws when it is invalid. Compression is off until this
+   * returns a non-empty string.
+   */
+  negotiate(header: string): string
+  /** Payload for one message (RSV1 set), without the trailing 00 00 ff ff */
+  compress(
+    message: ArrayBuffer,
+    byteOffset?: number,
+    byteLength?: number
+  ): ArrayBuffer
+  /** Inverse of compress() for a reassembled message payload */
+  decompress(
+    payload: ArrayBuffer,
+    byteOffset?: number,
+    byteLength?: number
+  ): ArrayBuffer
+  reset(): void
+}
+
+/**
+ * Decodes an HTTP body as it arrives. Decoded bytes go into the ring buffer
+ * passed to createContentDecoder(): `readable` bytes start at `readOffset`
+ * and wrap around to offset 0. Call consume() once they are read.
+ */
+export interface ContentDecoder
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  /** Decoded bytes in the ring not consumed yet */
+  readonly readable: number
+  /** Ring offset of the first unread byte */
+  readonly readOffset: number
+  /** True when the data so far is a complete stream */
+  readonly finished: boolean
+  /** Decodes a network chunk of any size, returns `readable` */
+  write(chunk: ArrayBuffer, byteOffset?: number, byteLength?: number): number
+  /** Frees read bytes and decodes input that was waiting for space, returns `readable` */
+  consume(bytes: number): number
+  /** Throws when the body stopped mid-stream */
+  end(): void
+}
+
+/**
+ * Bytes kept in native memory (compressed or inflated output). Pass it back
+ * to the *ToHandle methods as input, or copy it out with toArrayBuffer().
+ */
+export interface CompressedBuffer
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  readonly byteLength: number
+  /** A new ArrayBuffer with a copy of the bytes */
+  toArrayBuffer(): ArrayBuffer
+}
+
+export interface CompressedStoreOptions {
+  /** Compressed bytes kept before least recently used entries are evicted, default 64 MB */
+  maxCompressedBytes?: number
+  /** Decompressed bytes kept for recently read entries, default 8 MB, 0 turns it off */
+  maxHotBytes?: number
+  level?: ZlibCompressionLevel
+}
+
+/**
+ * Values kept as raw deflate in native memory. put() compresses on a worker
+ * thread, get() inflates on demand; least recently used entries are evicted
+ * once maxCompressedBytes is reached.
+ */
+export interface CompressedStore
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  /** Number of entries */
+  readonly size: number
+  readonly compressedBytes: number
+  /** Size of the stored values before compression */
+  readonly originalBytes: number
+  /** Decompressed bytes held in the hot tier */
+  readonly hotBytes: number
+  /** Entries dropped to stay under maxCompressedBytes */
+  readonly evictions: number
+  /** Resolves once the value is stored; a later put() or remove() of the key wins */
+  put(key: string, data: ArrayBuffer): Promise<void>
+  /** A fresh copy of the value, undefined when missing or evicted */
+  get(key: string): ArrayBuffer | undefined
+  has(key: string): boolean
+  remove(key: string): boolean
+  clear(): void
+}
+
 export interface Zlib extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
   readonly version: string
 
@@ -90,6 +364,63 @@ export interface Zlib extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
   gzip(data: ArrayBuffer, options?: ZlibOptions): Promise<ArrayBuffer>
   gunzip(data: ArrayBuffer, options?: ZlibOptions): Promise<ArrayBuffer>
 
+  // Inflate gzip, zlib or raw deflate, detected from the header bytes in one pass
+  unzipSync(data: ArrayBuffer, options?: ZlibOptions): ArrayBuffer
+  unzip(data: ArrayBuffer, options?: ZlibOptions): Promise<ArrayBuffer>
+
+  // Write into dst starting at dstOffset and return the bytes written, throw
+  // with the needed size when the output doesn't fit. dst must not overlap
+  // the input range
+  inflateInto(data: ArrayBuffer, dst: ArrayBuffer, dstOffset?: number, options?: ZlibOptions): number
+  gunzipInto(data: ArrayBuffer, dst: ArrayBuffer, dstOffset?: number, options?: ZlibOptions): number
+  deflateInto(data: ArrayBuffer, dst: ArrayBuffer, dstOffset?: number, options?: ZlibOptions): number
+
+  // UTF-8 strings straight into deflate, and inflated bytes straight into a
+  // JS string (the output must be UTF-8)
+  deflateString(text: string, options?: ZlibOptions): ArrayBuffer
+  gzipString(text: string, options?: ZlibOptions): ArrayBuffer
+  inflateToString(data: ArrayBuffer, options?: ZlibOptions): string
+  gunzipToString(data: ArrayBuffer, options?: ZlibOptions): string
+
+  // Compressed output as base64 text and back, without the binary buffer
+  // passing through JS
+  deflateToBase64(data: ArrayBuffer, options?: ZlibOptions): string
+  gzipToBase64(data: ArrayBuffer, options?: ZlibOptions): string
+  inflateFromBase64(base64: string, options?: ZlibOptions): ArrayBuffer
+  gunzipFromBase64(base64: string, options?: ZlibOptions): ArrayBuffer
+
+  // Output stays native until toArrayBuffer(); input may be a CompressedBuffer
+  deflateToHandle(data: ArrayBuffer | CompressedBuffer, options?: ZlibOptions): CompressedBuffer
+  gzipToHandle(data: ArrayBuffer | CompressedBuffer, options?: ZlibOptions): CompressedBuffer
+  inflateToHandle(data: ArrayBuffer | CompressedBuffer, options?: ZlibOptions): CompressedBuffer
+  gunzipToHandle(data: ArrayBuffer | CompressedBuffer, options?: ZlibOptions): CompressedBuffer
+  unzipToHandle(data: ArrayBuffer | CompressedBuffer, options?: ZlibOptions): CompressedBuffer
+
+  // Output as ArrayBuffers of segmentSize bytes (default 1 MB, the last one
+  // shorter), for results too large to allocate in one block
+  inflateSegmented(data: ArrayBuffer, segmentSize?: number, options?: ZlibOptions): Promise<ArrayBuffer[]>
+  gunzipSegmented(data: ArrayBuffer, segmentSize?: number, options?: ZlibOptions): Promise<ArrayBuffer[]>
+  unzipSegmented(data: ArrayBuffer, segmentSize?: number, options?: ZlibOptions): Promise<ArrayBuffer[]>
+
+  // Same as above, plus native timing, sizes, checksum and gzip header
+  inflateSyncWithInfo(data: ArrayBuffer, options?: ZlibOptions): ZlibResult
+  inflateRawSyncWithInfo(data: ArrayBuffer, options?: ZlibOptions): ZlibResult
+  compressSyncWithInfo(data: ArrayBuffer, options?: ZlibOptions): ZlibResult
+  deflateSyncWithInfo(data: ArrayBuffer, options?: ZlibOptions): ZlibResult
+  deflateRawSyncWithInfo(data: ArrayBuffer, options?: ZlibOptions): ZlibResult
+  gzipSyncWithInfo(data: ArrayBuffer, options?: ZlibOptions): ZlibResult
+  gunzipSyncWithInfo(data: ArrayBuffer, options?: ZlibOptions): ZlibResult
+  inflateWithInfo(data: ArrayBuffer, options?: ZlibOptions): Promise<ZlibResult>
+  inflateRawWithInfo(data: ArrayBuffer, options?: ZlibOptions): Promise<ZlibResult>
+  compressWithInfo(data: ArrayBuffer, options?: ZlibOptions): Promise<ZlibResult>
+  deflateWithInfo(data: ArrayBuffer, options?: ZlibOptions): Promise<ZlibResult>
+  deflateRawWithInfo(data: ArrayBuffer, options?: ZlibOptions): Promise<ZlibResult>
+  gzipWithInfo(data: ArrayBuffer, options?: ZlibOptions): Promise<ZlibResult>
+  gunzipWithInfo(data: ArrayBuffer, options?: ZlibOptions): Promise<ZlibResult>
+
+  // Experimental: speculative multi-threaded gunzip, falls back to gunzip()
+  gunzipParallel(data: ArrayBuffer, options?: ZlibOptions): Promise<ArrayBuffer>
+
   //Stream
   createDeflateStream(options?: ZlibOptions): ZlibStream
   createInflateStream(options?: ZlibOptions): ZlibStream
@@ -98,4 +429,24 @@ export interface Zlib extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
   createDeflateRawStream(options?: ZlibOptions): ZlibStream
   createInflateRawStream(options?: ZlibOptions): ZlibStream
   createUnzipStream(options?: ZlibOptions): ZlibStream
+
+  // WebSocket permessage-deflate, whole messages per call
+  createPerMessageDeflate(options: PerMessageDeflateOptions): PerMessageDeflate
+
+  // Content-Encoding gzip, x-gzip or deflate (zlib or raw) response bodies
+  createContentDecoder(encoding: string, ring: ArrayBuffer): ContentDecoder
+
+  // Token for ZlibOptions.signal
+  createAbortToken(): AbortToken
+
+  // In-memory LRU cache of compressed values
+  createCompressedStore(options?: CompressedStoreOptions): CompressedStore
+
+  // Metrics (off by default, only operations with at least one call are returned)
+  setMetricsEnabled(enabled: boolean): void
+  getMetrics(): OperationMetrics[]
+  resetMetrics(): void
+
+  // Benchmarks a grid of deflate parameters over the samples on native worker threads
+  tune(samples: ArrayBuffer[], objective?: TuneObjective): Promise<TuneResult>
 }